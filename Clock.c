@@ -0,0 +1,103 @@
+/*
+ * Clock.c
+ *
+ * Description: Helper file for the clock profiles
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Clock.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+typedef struct _ClockSettings
+{
+    uint32_t dcoFrequency;  // CS_DCO_FREQUENCY_*
+    uint32_t mclkHz;
+    uint32_t smclkDivider;  // CS_CLOCK_DIVIDER_* that gives CLOCK_SMCLK_HZ
+    uint_fast8_t vcore;     // PCM_VCORE*
+    uint32_t waitStates;    // Flash wait states of both banks
+} ClockSettings;
+
+/* Indexed by ClockProfile */
+static const ClockSettings settings[NUM_OF_CLOCK_PROFILES] = {
+        { CS_DCO_FREQUENCY_3, 3000000, CS_CLOCK_DIVIDER_1, PCM_VCORE0, 0 },
+        { CS_DCO_FREQUENCY_12, 12000000, CS_CLOCK_DIVIDER_4, PCM_VCORE0, 0 },
+        { CS_DCO_FREQUENCY_48, 48000000, CS_CLOCK_DIVIDER_16, PCM_VCORE1, 1 } };
+
+static ClockProfile current = CLOCK_3MHZ;
+static Clock_Listener listeners[NUM_OF_CLOCK_LISTENERS];
+
+/*!
+ * \brief This function sets the wait states of both flash banks
+ *
+ * \param waitStates is the number of wait states
+ *
+ * \return None
+ */
+void Clock_setWaitStates(uint32_t waitStates)
+{
+    FlashCtl_setWaitState(FLASH_BANK0, waitStates);
+    FlashCtl_setWaitState(FLASH_BANK1, waitStates);
+}
+
+void Clock_init(void)
+{
+    const ClockSettings *start = &settings[CLOCK_3MHZ];
+    current = CLOCK_3MHZ;
+    PCM_setCoreVoltageLevel(start->vcore);
+    Clock_setWaitStates(start->waitStates);
+    CS_setDCOCenteredFrequency(start->dcoFrequency);
+    CS_initClockSignal(CS_MCLK, CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+    CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, start->smclkDivider);
+}
+
+ClockProfile Clock_setProfile(ClockProfile profile)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    const ClockProfile previous = current;
+    const ClockSettings *from = &settings[previous];
+    const ClockSettings *to = &settings[profile];
+    if (to->mclkHz > from->mclkHz)
+    {
+        // The core voltage and wait states have to be up before MCLK is.
+        // The SMCLK divider goes first, so SMCLK never runs above its rate.
+        PCM_setCoreVoltageLevel(to->vcore);
+        Clock_setWaitStates(to->waitStates);
+        CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+        CS_setDCOCenteredFrequency(to->dcoFrequency);
+    }
+    else if (to->mclkHz < from->mclkHz)
+    {
+        CS_setDCOCenteredFrequency(to->dcoFrequency);
+        CS_initClockSignal(CS_SMCLK, CS_DCOCLK_SELECT, to->smclkDivider);
+        Clock_setWaitStates(to->waitStates);
+        PCM_setCoreVoltageLevel(to->vcore);
+    }
+    current = profile;
+    if (to->mclkHz != from->mclkHz)
+    {
+        int listener;
+        for (listener = 0; listener < NUM_OF_CLOCK_LISTENERS; listener++)
+        {
+            if (listeners[listener])
+            {
+                listeners[listener](from->mclkHz, to->mclkHz);
+            }
+        }
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return previous;
+}
+
+uint32_t Clock_getMCLK(void)
+{
+    return settings[current].mclkHz;
+}
+
+void Clock_listen(int listener, Clock_Listener callback)
+{
+    listeners[listener] = callback;
+}
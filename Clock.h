@@ -0,0 +1,100 @@
+/*
+ * Clock.h
+ *
+ * Description: Header file for the clock profiles. MCLK runs from the DCO at
+ *              3, 12 or 48 MHz and can be switched while the game runs. The
+ *              core voltage and flash wait states are set to what the
+ *              profile needs. SMCLK stays at 3 MHz in every profile, so the
+ *              Timer_A PWMs, the ADC14 trigger and the telemetry UART don't
+ *              see the switch. Drivers that count MCLK register a listener
+ *              and rescale when it changes.
+ *
+ *              The game only sets CLOCK_GAME_PROFILE once, in setup. Nothing
+ *              switches profiles at run time. A wake-up of the task loop is
+ *              too short to pay for two switches: in the simulator, running
+ *              each one at 12 MHz cost more time in switching than it saved.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+
+#define CLOCK_SMCLK_HZ                                              3000000
+
+/* Listeners, one per driver that counts MCLK */
+#define CLOCK_DELAYS                                                0
+#define CLOCK_PROFILER                                              1
+#define NUM_OF_CLOCK_LISTENERS                                      2
+
+typedef enum _ClockProfile
+{
+    CLOCK_3MHZ,             // Reset clock, VCORE0, for idling
+    CLOCK_12MHZ,            // VCORE0
+    CLOCK_48MHZ,            // VCORE1 and 1 flash wait state, for bursts
+    NUM_OF_CLOCK_PROFILES
+} ClockProfile;
+
+/* Profile the game runs in for good, can be set on the command line */
+#ifndef CLOCK_GAME_PROFILE
+#define CLOCK_GAME_PROFILE                                          CLOCK_3MHZ
+#endif
+
+typedef void (*Clock_Listener)(uint32_t oldMCLK, uint32_t newMCLK);
+
+/*!
+ * \brief This function starts the clock profiles at CLOCK_3MHZ
+ *
+ * This function must run before anything reads the MCLK frequency.
+ *
+ * \return None
+ */
+extern void Clock_init(void);
+
+/*!
+ * \brief This function switches to a clock profile
+ *
+ * Interrupts are masked while the clocks change and the listeners run.
+ *
+ * \param profile is the ClockProfile to switch to
+ *
+ * \return the ClockProfile that was in use, to switch back to
+ */
+extern ClockProfile Clock_setProfile(ClockProfile profile);
+
+/*!
+ * \brief This function gets the MCLK frequency
+ *
+ * Unlike CS_getMCLK this function doesn't compute the frequency, so it is
+ * cheap enough for interrupts.
+ *
+ * \return the MCLK frequency in Hz
+ */
+extern uint32_t Clock_getMCLK(void);
+
+/*!
+ * \brief This function registers a listener for MCLK changes
+ *
+ * The listener is called after MCLK changed, with interrupts masked.
+ * Registering a listener replaces the previous one.
+ *
+ * \param listener is the listener, CLOCK_DELAYS etc.
+ * \param callback is the function to call
+ *
+ * \return None
+ */
+extern void Clock_listen(int listener, Clock_Listener callback);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,24 @@
+/*
+ * DMAControl.c
+ *
+ * Description: Helper file for the shared uDMA control table
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <DMAControl.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Primary and alternate structures for every channel, must be 1024 aligned */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(dmaControlTable, 1024)
+static DMA_ControlTable dmaControlTable[32];
+#elif defined(__GNUC__)
+static DMA_ControlTable dmaControlTable[32] __attribute__ ((aligned (1024)));
+#endif
+
+void DMAControl_init(void)
+{
+    DMA_enableModule();
+    DMA_setControlBase(dmaControlTable);
+}
@@ -0,0 +1,35 @@
+/*
+ * DMAControl.h
+ *
+ * Description: Header file for the shared uDMA control table. Every module
+ *              that uses a DMA channel sets its channel up in this table.
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef DMACONTROL_H_
+#define DMACONTROL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/*!
+ * \brief This function initializes the uDMA controller
+ *
+ * This function enables the uDMA module and points it at the control table.
+ * It must be called before any module sets up a DMA channel.
+ *
+ * \return None
+ */
+extern void DMAControl_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DMACONTROL_H_ */
@@ -0,0 +1,74 @@
+/*
+ * Filter.c
+ *
+ * Description: Helper file for the fixed-point sensor filters
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Filter.h>
+
+void Filter_init(SensorFilter *filter, FilterMode mode, int32_t param)
+{
+    filter->mode = mode;
+    filter->param = param;
+    filter->state = 0;
+    filter->index = 0;
+    filter->count = 0;
+}
+
+uint16_t Filter_update(SensorFilter *filter, uint16_t sample)
+{
+    int i;
+    switch (filter->mode)
+    {
+    case FILTER_AVERAGE:
+        if (filter->count == 0)
+        {
+            // Fill the window so the average starts at the first sample
+            for (i = 0; i < filter->param; i++)
+            {
+                filter->window[i] = sample;
+            }
+            filter->state = (int32_t) sample * filter->param;
+            filter->count = 1;
+        }
+        filter->state += (int32_t) sample - filter->window[filter->index];
+        filter->window[filter->index] = sample;
+        filter->index = (filter->index + 1) & (filter->param - 1);
+        return (filter->state + filter->param / 2) / filter->param;
+    case FILTER_IIR:
+        if (filter->count == 0)
+        {
+            filter->state = (int32_t) sample << 15;
+            filter->count = 1;
+        }
+        // 64-bit product, the difference alone needs 30 bits
+        filter->state += ((int64_t) filter->param
+                * (((int32_t) sample << 15) - filter->state)) >> 15;
+        return (filter->state + (Q15_ONE / 2)) >> 15;
+    default:
+        return sample;
+    }
+}
+
+void Quantizer_init(Quantizer *quantizer, int32_t size, int32_t hysteresis,
+                    int32_t value)
+{
+    quantizer->size = size;
+    quantizer->hysteresis = hysteresis;
+    quantizer->bucket = value / size;
+}
+
+bool Quantizer_update(Quantizer *quantizer, int32_t value)
+{
+    int32_t low = quantizer->bucket * quantizer->size;
+    // Stay in the bucket until the value is clearly past one of its edges
+    if (value >= low - quantizer->hysteresis
+            && value < low + quantizer->size + quantizer->hysteresis)
+    {
+        return false;
+    }
+    quantizer->bucket = value / quantizer->size;
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+ * Filter.h
+ *
+ * Description: Header file for the fixed-point sensor filters. A filter
+ *              smooths 14-bit ADC samples with either a moving average or a
+ *              one-pole IIR whose coefficient is in Q15. A quantizer then
+ *              maps the smoothed value to buckets, such as 10 degree angles
+ *              or 10 mV steps, with hysteresis so noise at a bucket edge
+ *              doesn't make it flicker.
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Longest moving average, must be a power of two
+#define FILTER_MAX_LENGTH                                           16
+#define Q15_ONE                                                     32768
+#define Q15(x)                                 ((int32_t) ((x) * Q15_ONE))
+
+typedef enum _FilterMode
+{
+    FILTER_NONE, FILTER_AVERAGE, FILTER_IIR
+} FilterMode;
+
+typedef struct _SensorFilter
+{
+    FilterMode mode;
+    int32_t param;      // Averaged samples, or IIR coefficient in Q15
+    int32_t state;      // Running sum, or IIR output in Q15
+    uint16_t window[FILTER_MAX_LENGTH];
+    uint8_t index;
+    uint8_t count;
+} SensorFilter;
+
+typedef struct _Quantizer
+{
+    int32_t size;       // Width of a bucket
+    int32_t hysteresis; // Distance past an edge needed to change bucket
+    int32_t bucket;     // Current bucket, value / size
+} Quantizer;
+
+/*!
+ * \brief This function sets up a filter
+ *
+ * \param filter is the filter to set up
+ * \param mode is the type of filter
+ *          - \b FILTER_NONE: samples pass through
+ *          - \b FILTER_AVERAGE: mean of the last param samples, param is a
+ *              power of two up to FILTER_MAX_LENGTH
+ *          - \b FILTER_IIR: y += param * (x - y), param is Q15(0.0 - 1.0)
+ * \param param is the length or coefficient, see mode
+ *
+ * \return None
+ */
+extern void Filter_init(SensorFilter *filter, FilterMode mode, int32_t param);
+
+/*!
+ * \brief This function feeds a sample through a filter
+ *
+ * The first sample after Filter_init fills the filter, so the output doesn't
+ * ramp up from 0.
+ *
+ * \param filter is the filter to update
+ * \param sample is the new 14-bit sample
+ *
+ * \return the filtered sample, rounded to the nearest count
+ */
+extern uint16_t Filter_update(SensorFilter *filter, uint16_t sample);
+
+/*!
+ * \brief This function sets up a quantizer
+ *
+ * \param quantizer is the quantizer to set up
+ * \param size is the width of a bucket
+ * \param hysteresis is how far past a bucket edge a value must go, less than
+ *          half of size
+ * \param value is the starting value
+ *
+ * \return None
+ */
+extern void Quantizer_init(Quantizer *quantizer, int32_t size,
+                           int32_t hysteresis, int32_t value);
+
+/*!
+ * \brief This function feeds a value through a quantizer
+ *
+ * \param quantizer is the quantizer to update
+ * \param value is the new value, must not be negative
+ *
+ * \return true if the bucket changed
+ */
+extern bool Quantizer_update(Quantizer *quantizer, int32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FILTER_H_ */
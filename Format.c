@@ -0,0 +1,99 @@
+/*
+ * Format.c
+ *
+ * Description: Helper file for formatting numbers as LCD text
+ *
+ *  Created on: Mar 5, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Format.h>
+
+static const uint16_t powersOfTen[] = { 1, 10, 100, 1000, 10000 };
+
+/*!
+ * \brief This function writes the digits of a number with padding
+ *
+ * \param buffer is where the characters are written
+ * \param digits are the digits, least significant first
+ * \param count is the number of digits
+ * \param width is the least number of characters
+ *
+ * \return the number of characters written
+ */
+int Format_pad(char *buffer, const char *digits, int count, int width)
+{
+    int length = 0;
+    while (width-- > count)
+    {
+        buffer[length++] = ' ';
+    }
+    while (count > 0)
+    {
+        buffer[length++] = digits[--count];
+    }
+    return length;
+}
+
+int Format_uint(char *buffer, uint32_t value, int width)
+{
+    char digits[FORMAT_MAX_DIGITS];
+    int count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    }
+    while (value);
+    return Format_pad(buffer, digits, count, width);
+}
+
+int Format_int(char *buffer, int32_t value, int width)
+{
+    if (value >= 0)
+    {
+        return Format_uint(buffer, value, width);
+    }
+    // Negated as unsigned so INT32_MIN works
+    uint32_t magnitude = -(uint32_t) value;
+    char digits[FORMAT_MAX_DIGITS + 1];
+    int count = 0;
+    do
+    {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    }
+    while (magnitude);
+    digits[count++] = '-';
+    return Format_pad(buffer, digits, count, width);
+}
+
+int Format_fixed(char *buffer, uint32_t value, int decimals, int width)
+{
+    char digits[FORMAT_MAX_DIGITS + 2];
+    int count = 0;
+    // Fraction digits, then the point, then at least one integer digit
+    while (count < decimals)
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    }
+    digits[count++] = '.';
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    }
+    while (value);
+    return Format_pad(buffer, digits, count, width);
+}
+
+int Format_q(char *buffer, uint32_t value, int fractionBits, int decimals,
+             int width)
+{
+    uint32_t whole = value >> fractionBits;
+    uint32_t fraction = value & ((1UL << fractionBits) - 1);
+    uint32_t scale = powersOfTen[decimals];
+    // Round to the nearest last decimal, which can carry into the whole part
+    fraction = (fraction * scale + (1UL << (fractionBits - 1))) >> fractionBits;
+    return Format_fixed(buffer, whole * scale + fraction, decimals, width);
+}
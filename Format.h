@@ -0,0 +1,88 @@
+/*
+ * Format.h
+ *
+ * Description: Header file for formatting numbers as LCD text without printf.
+ *              Every function writes right-aligned characters into a buffer
+ *              and returns how many it wrote. Nothing is NUL-terminated, the
+ *              result is meant for setFrameString.
+ *
+ *  Created on: Mar 5, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Degree glyph in the HD44780 character ROM */
+#define FORMAT_DEGREE                                               0xDF
+// Longest uint32_t in decimal
+#define FORMAT_MAX_DIGITS                                           10
+
+/*!
+ * \brief This function formats an unsigned integer
+ *
+ * \param buffer is where the characters are written
+ * \param value is the number to format
+ * \param width is the least number of characters, padded with spaces on the
+ *          left, 0 for no padding
+ *
+ * \return the number of characters written
+ */
+extern int Format_uint(char *buffer, uint32_t value, int width);
+
+/*!
+ * \brief This function formats a signed integer
+ *
+ * \param buffer is where the characters are written
+ * \param value is the number to format
+ * \param width is the least number of characters, padded with spaces on the
+ *          left, 0 for no padding
+ *
+ * \return the number of characters written
+ */
+extern int Format_int(char *buffer, int32_t value, int width);
+
+/*!
+ * \brief This function formats a decimal fixed-point number
+ *
+ * For example 329 with 2 decimals is written as 3.29.
+ *
+ * \param buffer is where the characters are written
+ * \param value is the number times 10^decimals
+ * \param decimals is the number of digits after the point, 1 - 4
+ * \param width is the least number of characters, padded with spaces on the
+ *          left, 0 for no padding
+ *
+ * \return the number of characters written
+ */
+extern int Format_fixed(char *buffer, uint32_t value, int decimals, int width);
+
+/*!
+ * \brief This function formats a binary fixed-point (Q format) number
+ *
+ * The fraction is rounded to the given number of decimals.
+ *
+ * \param buffer is where the characters are written
+ * \param value is the number in Q format
+ * \param fractionBits is the number of fraction bits of value, 1 - 16
+ * \param decimals is the number of digits after the point, 1 - 4
+ * \param width is the least number of characters, padded with spaces on the
+ *          left, 0 for no padding
+ *
+ * \return the number of characters written
+ */
+extern int Format_q(char *buffer, uint32_t value, int fractionBits,
+                    int decimals, int width);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FORMAT_H_ */
@@ -0,0 +1,242 @@
+/*
+ * HAL.h
+ *
+ * Description: Header file for the register accesses DriverLib has no
+ *              function for. On the MSP432 these are inline register reads
+ *              and writes. When HAL_HOST is defined they are implemented by
+ *              the simulated peripherals in host/, so the firmware also builds
+ *              and runs on Linux. Everything else goes through DriverLib,
+ *              which host/ provides its own version of.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#ifdef HAL_HOST
+
+extern uint8_t HAL_readPort(uint_fast8_t port);
+extern uint16_t HAL_readTimerCount(uint32_t timer);
+extern bool HAL_isTimerOverflowPending(uint32_t timer);
+extern uint16_t HAL_readTimerVector(uint32_t timer);
+extern void HAL_stopADCSequence(void);
+extern void HAL_setADCWindow(uint_fast8_t window, uint16_t low, uint16_t high);
+extern volatile void* HAL_getADCResultAddress(int mem);
+extern volatile void* HAL_getUARTTransmitAddress(void);
+extern volatile void* HAL_getTimerCompareAddress(uint32_t timer,
+                                                 uint_fast16_t compareRegister);
+extern void HAL_loadSysTick(uint32_t ticks);
+extern bool HAL_isSysTickExpired(void);
+extern void HAL_startCycleCounter(void);
+extern uint32_t HAL_readCycleCount(void);
+/* Only on the simulated board, Profile.c reads the exception frame instead */
+extern uint32_t HAL_readInterruptedPC(void);
+
+#else
+
+/*!
+ * \brief This function reads the input register of a port
+ *
+ * \param port is the GPIO_PORT_Px of the port
+ *
+ * \return the level of every pin of the port
+ */
+static inline uint8_t HAL_readPort(uint_fast8_t port)
+{
+    switch (port)
+    {
+    case GPIO_PORT_P1:
+        return P1->IN;
+    case GPIO_PORT_P2:
+        return P2->IN;
+    case GPIO_PORT_P3:
+        return P3->IN;
+    case GPIO_PORT_P4:
+        return P4->IN;
+    case GPIO_PORT_P5:
+        return P5->IN;
+    case GPIO_PORT_P6:
+        return P6->IN;
+    default:
+        return 0;
+    }
+}
+
+/*!
+ * \brief This function reads the count of a TimerA
+ *
+ * \param timer is the base address of the TimerA
+ *
+ * \return the value of TAxR
+ */
+static inline uint16_t HAL_readTimerCount(uint32_t timer)
+{
+    return ((Timer_A_Type*) timer)->R;
+}
+
+/*!
+ * \brief This function checks whether a TimerA overflowed
+ *
+ * \param timer is the base address of the TimerA
+ *
+ * \return true if TAIFG is set
+ */
+static inline bool HAL_isTimerOverflowPending(uint32_t timer)
+{
+    return (((Timer_A_Type*) timer)->CTL & TIMER_A_CTL_IFG) != 0;
+}
+
+/*!
+ * \brief This function reads the interrupt vector of a TimerA
+ *
+ * Reading the vector clears the flag it reports.
+ *
+ * \param timer is the base address of the TimerA
+ *
+ * \return the value of TAxIV, 0 if nothing is pending
+ */
+static inline uint16_t HAL_readTimerVector(uint32_t timer)
+{
+    return ((Timer_A_Type*) timer)->IV;
+}
+
+/*!
+ * \brief This function stops the ADC14 sequence right away
+ *
+ * A repeat sequence only stops at its end when ENC is cleared, so CONSEQ is
+ * cleared along with it.
+ *
+ * \return None
+ */
+static inline void HAL_stopADCSequence(void)
+{
+    ADC14->CTL0 &= ~(ADC14_CTL0_CONSEQ_MASK | ADC14_CTL0_ENC);
+}
+
+/*!
+ * \brief This function sets the thresholds of an ADC14 comparator window
+ *
+ * DriverLib refuses to change the thresholds while a sequence is running, so
+ * the registers are written directly.
+ *
+ * \param window is ADC_COMP_WINDOW0 or ADC_COMP_WINDOW1
+ * \param low is the lower threshold
+ * \param high is the upper threshold
+ *
+ * \return None
+ */
+static inline void HAL_setADCWindow(uint_fast8_t window, uint16_t low,
+                                    uint16_t high)
+{
+    if (window == ADC_COMP_WINDOW0)
+    {
+        ADC14->LO0 = low;
+        ADC14->HI0 = high;
+    }
+    else
+    {
+        ADC14->LO1 = low;
+        ADC14->HI1 = high;
+    }
+}
+
+/*!
+ * \brief This function gets the address of an ADC14 result register
+ *
+ * \param mem is the number of the conversion memory, 0 - 31
+ *
+ * \return the address of ADC14MEMx, for the uDMA
+ */
+static inline volatile void* HAL_getADCResultAddress(int mem)
+{
+    return &ADC14->MEM[mem];
+}
+
+/*!
+ * \brief This function gets the address of the eUSCI_A0 transmit buffer
+ *
+ * \return the address of UCA0TXBUF, for the uDMA
+ */
+static inline volatile void* HAL_getUARTTransmitAddress(void)
+{
+    return &EUSCI_A0->TXBUF;
+}
+
+/*!
+ * \brief This function gets the address of a TimerA compare register
+ *
+ * \param timer is the base address of the TimerA
+ * \param compareRegister is TIMER_A_CAPTURECOMPARE_REGISTER_0 - 6
+ *
+ * \return the address of TAxCCRn, for the uDMA
+ */
+static inline volatile void* HAL_getTimerCompareAddress(
+        uint32_t timer, uint_fast16_t compareRegister)
+{
+    return &((Timer_A_Type*) timer)->CCR[(compareRegister >> 1) - 1];
+}
+
+/*!
+ * \brief This function loads the SysTick period and restarts the count
+ *
+ * \param ticks is the number of MCLK cycles until the count expires
+ *
+ * \return None
+ */
+static inline void HAL_loadSysTick(uint32_t ticks)
+{
+    SysTick->LOAD = ticks - 1;
+    // Write any value to reset timer counter
+    SysTick->VAL = 1;
+}
+
+/*!
+ * \brief This function checks whether the SysTick count expired
+ *
+ * The flag is cleared by the read.
+ *
+ * \return true if the count reached zero since the last check
+ */
+static inline bool HAL_isSysTickExpired(void)
+{
+    return (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0;
+}
+
+/*!
+ * \brief This function starts the DWT cycle counter from 0
+ *
+ * \return None
+ */
+static inline void HAL_startCycleCounter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*!
+ * \brief This function reads the DWT cycle counter
+ *
+ * \return the MCLK cycles since the counter started, wrapping at 2^32
+ */
+static inline uint32_t HAL_readCycleCount(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* HAL_HOST */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_H_ */
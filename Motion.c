@@ -0,0 +1,180 @@
+/*
+ * Motion.c
+ *
+ * Description: Helper file for the servo motion planner
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Motion.h>
+#include <Clock.h>
+#include <HAL.h>
+#include <Probe.h>
+#include <outputs.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* CCR1 counts from 0 to 180 degrees, CCR1 goes down as the angle goes up */
+#define SERVO_RANGE                               (MAX_ANGLE - MIN_ANGLE)
+/* Speeds and positions are planned in 1/256 of a CCR1 count */
+#define FRACTION_BITS                                               8
+#define MOTION_CHANNEL                                              2
+
+/* TA1CCR1 of each PWM period of the move, read by the uDMA */
+static uint16_t steps[MOTION_MAX_STEPS];
+static int stepCount = 0;
+static volatile Motion_Callback onDone;
+
+/*!
+ * \brief This function converts a rate in degrees per second
+ *
+ * TimerA1 counts SMCLK / 2 and a PWM period is SERVO_PERIOD counts.
+ *
+ * \param degreesPerSecond is the rate to convert
+ *
+ * \return the rate in 1/256 CCR1 counts per PWM period
+ */
+int32_t Motion_perPeriod(int32_t degreesPerSecond)
+{
+    return ((int64_t) degreesPerSecond * SERVO_RANGE * SERVO_PERIOD * 2
+            << FRACTION_BITS) / (180LL * CLOCK_SMCLK_HZ);
+}
+
+/*!
+ * \brief This function plans a move into the step table
+ *
+ * Each period the speed goes up by the acceleration, up to the highest speed,
+ * unless stopping from it would overshoot the target, then it goes down. It
+ * never goes below one period's acceleration, so the move always ends.
+ *
+ * \param from is the CCR1 value the servo is at
+ * \param to is the CCR1 value to move to
+ * \param top is the highest speed in 1/256 counts per period
+ * \param speed is the current speed in 1/256 counts per period, positive
+ *          towards increasing CCR1
+ *
+ * \return the number of steps, at least 1
+ */
+int Motion_plan(int32_t from, int32_t to, int32_t top, int32_t speed)
+{
+    const int32_t direction = to < from ? -1 : 1;
+    const int64_t distance = (int64_t) (to - from) * direction
+            << FRACTION_BITS;
+    const int64_t accel = (int64_t) Motion_perPeriod(MOTION_ACCEL)
+            * SERVO_PERIOD * 2 / CLOCK_SMCLK_HZ;
+    int64_t v = speed * direction;
+    int64_t traveled = 0;
+    int count = 0;
+    while (count < MOTION_MAX_STEPS - 1)
+    {
+        if (v > 0 && v * v >= 2 * accel * (distance - traveled))
+        {
+            v = v - accel < accel ? accel : v - accel;
+        }
+        else
+        {
+            v = v + accel > top ? top : v + accel;
+        }
+        traveled += v;
+        if (traveled >= distance)
+        {
+            break;
+        }
+        steps[count++] = from
+                + direction * (int32_t) (traveled / (1 << FRACTION_BITS));
+    }
+    // A move too long for the table ends with a jump
+    steps[count++] = to;
+    return count;
+}
+
+void Motion_init(void)
+{
+    DMA_assignChannel(DMA_CH2_TIMERA1CCR0);
+    DMA_disableChannelAttribute(DMA_CH2_TIMERA1CCR0,
+    UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY |
+    UDMA_ATTR_REQMASK);
+    // One halfword into TA1CCR1 per TA1CCR0 match
+    DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH2_TIMERA1CCR0,
+    UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+    DMA_assignInterrupt(DMA_INT2, MOTION_CHANNEL);
+    DMA_enableInterrupt(INT_DMA_INT2);
+    Interrupt_enableInterrupt(INT_DMA_INT2);
+}
+
+void Motion_moveTo(int degrees, int speed, Motion_Callback callback)
+{
+    if (degrees < 0)
+    {
+        degrees = 0;
+    }
+    else if (degrees > 180)
+    {
+        degrees = 180;
+    }
+    if (speed < MOTION_MIN_SPEED)
+    {
+        speed = MOTION_MIN_SPEED;
+    }
+
+    // Stop the running move where it is and take over its speed
+    bool wasDisabled = Interrupt_disableMaster();
+    int32_t current = 0;
+    if (DMA_isChannelEnabled(MOTION_CHANNEL))
+    {
+        DMA_disableChannel(MOTION_CHANNEL);
+        const int loaded = stepCount
+                - DMA_getChannelSize(UDMA_PRI_SELECT | DMA_CH2_TIMERA1CCR0);
+        if (loaded >= 2)
+        {
+            current = (steps[loaded - 1] - steps[loaded - 2])
+                    * (1 << FRACTION_BITS);
+        }
+    }
+    DMA_clearInterruptFlag(MOTION_CHANNEL);
+    Interrupt_unpendInterrupt(INT_DMA_INT2);
+    onDone = 0;
+    const int32_t from = Timer_A_getCaptureCompareCount(
+            TIMER_A1_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_1);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+
+    // The servo holds its pulse width while the move is planned
+    stepCount = Motion_plan(from, MAX_ANGLE - degrees * SERVO_RANGE / 180,
+                            Motion_perPeriod(speed), current);
+    wasDisabled = Interrupt_disableMaster();
+    onDone = callback;
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH2_TIMERA1CCR0,
+                           UDMA_MODE_BASIC, steps,
+                           (void*) HAL_getTimerCompareAddress(
+                                   TIMER_A1_BASE,
+                                   TIMER_A_CAPTURECOMPARE_REGISTER_1),
+                           stepCount);
+    DMA_enableChannel(MOTION_CHANNEL);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+/*!
+ * \brief This function handles the DMA_INT2 interrupt
+ *
+ * This function runs once the last step of a move is in TA1CCR1 and calls the
+ * move's callback.
+ *
+ * \return None
+ */
+void DMA_INT2_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    DMA_clearInterruptFlag(MOTION_CHANNEL);
+    const Motion_Callback callback = onDone;
+    onDone = 0;
+    if (callback)
+    {
+        callback();
+    }
+    PROBE_END(probe, PROBE_DMA_INT2);
+}
@@ -0,0 +1,66 @@
+/*
+ * Motion.h
+ *
+ * Description: Header file for the servo motion planner. A move is planned
+ *              once, as a trapezoidal speed profile: it speeds up at
+ *              MOTION_ACCEL, cruises at the speed asked for and slows down
+ *              to stop on the target. The plan is a table of TA1CCR1 values,
+ *              one per servo PWM period, and the uDMA copies the next one
+ *              into TA1CCR1 on every TA1CCR0 match. The CPU only runs again
+ *              when the move is over.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef MOTION_H_
+#define MOTION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+
+/* Acceleration and deceleration in degrees per second squared */
+#define MOTION_ACCEL                                                1500
+/* Slower moves are sped up so the longest one fits MOTION_MAX_STEPS */
+#define MOTION_MIN_SPEED                                            45
+/* PWM periods a move can take, about 6.4 s */
+#define MOTION_MAX_STEPS                                            256
+
+typedef void (*Motion_Callback)(void);
+
+/*!
+ * \brief This function initializes the motion planner
+ *
+ * This function sets up uDMA channel 2 to be triggered by TA1CCR0 and its
+ * DMA_INT2 interrupt. outputs_init and DMAControl_init must be called first.
+ *
+ * \return None
+ */
+extern void Motion_init(void);
+
+/*!
+ * \brief This function moves the servo to an angle
+ *
+ * The move starts from where the servo is, at the speed it already has, so
+ * a new target can be given while a move runs. The callback of that move
+ * then won't run. This function is called from the task loop, not from
+ * interrupts or callbacks.
+ *
+ * \param degrees is the angle to move to, 0 - 180
+ * \param speed is the highest speed in degrees per second
+ * \param callback is the function to call from the DMA_INT2 interrupt once
+ *          the last pulse width is loaded, or 0
+ *
+ * \return None
+ */
+extern void Motion_moveTo(int degrees, int speed, Motion_Callback callback);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTION_H_ */
@@ -0,0 +1,124 @@
+/*
+ * Power.c
+ *
+ * Description: Helper file for low-power idling
+ *
+ *  Created on: Mar 3, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Power.h>
+#include <Timebase.h>
+#include <Tick.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+static volatile uint8_t wakeFlags = 0;
+static TickTimer timeoutTimer;
+/* Set from LPM0 until the interrupts that woke the CPU have run */
+static volatile bool asleep = false;
+
+/* Residency counters, also readable from the debugger */
+static uint32_t statsStart = 0;
+static uint32_t sleepTicks = 0;
+static uint32_t wakeups = 0;
+
+void Power_wake(uint8_t sources)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    wakeFlags |= sources;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+/*!
+ * \brief This function posts WAKE_TIMEOUT for Power_sleepFor
+ *
+ * \return None
+ */
+void Power_timeout(void)
+{
+    Power_wake(WAKE_TIMEOUT);
+}
+
+uint8_t Power_sleep(uint8_t sources)
+{
+    while (1)
+    {
+        // Masked so a source posted after the check still ends the WFI
+        Interrupt_disableMaster();
+        uint8_t woken = wakeFlags & sources;
+        if (woken)
+        {
+            wakeFlags &= ~woken;
+            Interrupt_enableMaster();
+            return woken;
+        }
+        uint32_t start = Timebase_now();
+        asleep = true;
+        PCM_gotoLPM0();
+        sleepTicks += Timebase_now() - start;
+        wakeups++;
+        // The interrupt that woke the CPU runs here
+        Interrupt_enableMaster();
+        asleep = false;
+    }
+}
+
+uint8_t Power_sleepFor(uint8_t sources, uint32_t ms)
+{
+    // Forget a timeout left over from an earlier call
+    Interrupt_disableMaster();
+    wakeFlags &= ~WAKE_TIMEOUT;
+    Interrupt_enableMaster();
+    Tick_start(&timeoutTimer, ms, 0, Power_timeout);
+    uint8_t woken = Power_sleep(sources | WAKE_TIMEOUT);
+    Tick_cancel(&timeoutTimer);
+    return woken & sources;
+}
+
+void Power_sleepForever(void)
+{
+    Interrupt_disableMaster();
+    // TimerA3 counts ACLK in LPM3, a pending interrupt would end every WFI
+    Timer_A_stopTimer(TIMER_A3_BASE);
+    Timer_A_disableInterrupt(TIMER_A3_BASE);
+    Timer_A_disableCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    Timer_A_clearInterruptFlag(TIMER_A3_BASE);
+    Timer_A_clearCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    // Nothing may wake the CPU anymore, not even a key press
+    uint32_t interrupt;
+    for (interrupt = FAULT_PENDSV; interrupt <= INT_PORT6; interrupt++)
+    {
+        Interrupt_disableInterrupt(interrupt);
+        Interrupt_unpendInterrupt(interrupt);
+    }
+    while (1)
+    {
+        PCM_gotoLPM3();
+    }
+}
+
+bool Power_isAsleep(void)
+{
+    return asleep;
+}
+
+void Power_getStats(PowerStats *stats)
+{
+    stats->totalTicks = Timebase_now() - statsStart;
+    stats->sleepTicks = sleepTicks;
+    stats->wakeups = wakeups;
+    stats->activePercent =
+            stats->totalTicks == 0 ? 1000 :
+                    1000 - (uint64_t) sleepTicks * 1000 / stats->totalTicks;
+}
+
+void Power_resetStats(void)
+{
+    statsStart = Timebase_now();
+    sleepTicks = 0;
+    wakeups = 0;
+}
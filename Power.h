@@ -0,0 +1,121 @@
+/*
+ * Power.h
+ *
+ * Description: Header file for low-power idling. Code that waits sleeps in
+ *              LPM0 until an interrupt posts one of the wake sources it is
+ *              waiting for. Time spent asleep is counted so active-mode
+ *              residency can be read back.
+ *
+ *  Created on: Mar 3, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Wake sources, posted by interrupts with Power_wake */
+#define WAKE_TIMER                                                  0x01
+#define WAKE_KEYPAD                                                 0x02
+#define WAKE_SWITCHES                                               0x04
+#define WAKE_ADC                                                    0x08
+#define WAKE_SYSTICK                                                0x10
+#define WAKE_TIMEOUT                                                0x20
+#define WAKE_TELEMETRY                                              0x40
+
+typedef struct _PowerStats
+{
+    uint32_t totalTicks;    // Timebase ticks since the stats were reset
+    uint32_t sleepTicks;    // Timebase ticks spent in LPM0
+    uint32_t wakeups;       // Number of times the CPU woke up
+    uint16_t activePercent; // Active-mode residency in 0.1 % units
+} PowerStats;
+
+/*!
+ * \brief This function posts wake sources
+ *
+ * This function is called from interrupts to wake code waiting in Power_sleep
+ * or Power_sleepFor. A posted source stays set until a sleep that waits for it
+ * returns, so a wake-up can't be missed.
+ *
+ * \param sources is the mask of WAKE_ sources to post
+ *
+ * \return None
+ */
+extern void Power_wake(uint8_t sources);
+
+/*!
+ * \brief This function sleeps until a wake source is posted
+ *
+ * This function idles the CPU in LPM0 until any of the given sources has been
+ * posted. The sources that woke it are cleared.
+ *
+ * \param sources is the mask of WAKE_ sources to wait for
+ *
+ * \return the mask of sources that were posted
+ */
+extern uint8_t Power_sleep(uint8_t sources);
+
+/*!
+ * \brief This function sleeps until a wake source is posted or time runs out
+ *
+ * This function works like Power_sleep but also wakes after the given number
+ * of milliseconds, measured by a software timer.
+ *
+ * \param sources is the mask of WAKE_ sources to wait for, may be 0
+ * \param ms is the longest time to sleep in milliseconds
+ *
+ * \return the mask of sources that were posted, 0 on timeout
+ */
+extern uint8_t Power_sleepFor(uint8_t sources, uint32_t ms);
+
+/*!
+ * \brief This function puts the device to sleep for good
+ *
+ * This function is used once the game is over. Nothing runs anymore, so it
+ * uses LPM3, where MCLK and SMCLK are stopped. ACLK keeps running, so TimerA3
+ * is halted and every interrupt is disabled and cleared first, else one left
+ * pending would end each WFI right away.
+ *
+ * \return None
+ */
+extern void Power_sleepForever(void);
+
+/*!
+ * \brief This function checks whether the CPU was woken from LPM0 and the
+ *          interrupts that woke it have not all run yet
+ *
+ * This function is for interrupts that want to know whether they woke the
+ * CPU, like the profiler.
+ *
+ * \return true from entering LPM0 until the interrupts that woke the CPU ran
+ */
+extern bool Power_isAsleep(void);
+
+/*!
+ * \brief This function reads the sleep counters
+ *
+ * \param stats is where the counters are stored
+ *
+ * \return None
+ */
+extern void Power_getStats(PowerStats *stats);
+
+/*!
+ * \brief This function resets the sleep counters
+ *
+ * \return None
+ */
+extern void Power_resetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_H_ */
@@ -0,0 +1,67 @@
+/*
+ * Probe.c
+ *
+ * Description: Helper file for the cycle-count probes, only built with
+ *              PROBE_ENABLE
+ *
+ *  Created on: Mar 8, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Probe.h>
+
+#ifdef PROBE_ENABLE
+
+/* Standard Includes */
+#include <string.h>
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Measurements of every probe, also readable from the debugger */
+ProbeStats probeStats[NUM_OF_PROBES];
+
+void Probe_init(void)
+{
+    HAL_startCycleCounter();
+    Probe_reset();
+}
+
+void Probe_record(ProbeId probe, uint32_t cycles)
+{
+    // log2 of the cycles, 0 and 1 both go in the first bucket
+    int bucket = 0;
+    uint32_t rest = cycles;
+    while (rest >>= 1)
+    {
+        bucket++;
+    }
+
+    bool wasDisabled = Interrupt_disableMaster();
+    ProbeStats *stats = &probeStats[probe];
+    if (stats->count == 0 || cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->count++;
+    stats->total += cycles;
+    stats->histogram[bucket]++;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+void Probe_reset(void)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    memset(probeStats, 0, sizeof(probeStats));
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+#endif /* PROBE_ENABLE */
@@ -0,0 +1,117 @@
+/*
+ * Probe.h
+ *
+ * Description: Header file for cycle-count probes. A probe times the code
+ *              between PROBE_BEGIN and PROBE_END with the DWT cycle counter
+ *              and keeps the count, min, max, total and a log2 histogram of
+ *              the cycles in RAM, readable from the debugger as probeStats.
+ *              Probes measure elapsed MCLK cycles, so code that sleeps in
+ *              between, like the LCD delays, may include the time asleep.
+ *
+ *              Probes are only built when PROBE_ENABLE is defined, otherwise
+ *              every macro here expands to nothing.
+ *
+ *  Created on: Mar 8, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef PROBE_H_
+#define PROBE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+
+/* Bucket b of the histogram counts 2^b to 2^(b + 1) - 1 cycles */
+#define PROBE_BUCKETS                                               32
+
+/* The probes, each one times one piece of code */
+typedef enum _ProbeId
+{
+    // Interrupt handlers
+    PROBE_TA3_0, PROBE_TA3_N, PROBE_PENDSV, PROBE_PORT1,
+    PROBE_PORT4, PROBE_DMA_INT1, PROBE_DMA_INT2, PROBE_ADC14,
+    // Steps of the tasks, in the order of Tasks
+    PROBE_TASK_PASSWORD, PROBE_TASK_LIGHTS, PROBE_TASK_TEMP,
+    PROBE_TASK_DIRECTION, PROBE_TASK_POWER, PROBE_TASK_REACTION,
+    PROBE_TASK_BINARY,
+    // Keypad and LCD drivers
+    PROBE_KEYPAD_SCAN, PROBE_LCD_FLUSH, PROBE_LCD_PRINT,
+    PROBE_LCD_INSTRUCTION,
+    NUM_OF_PROBES
+} ProbeId;
+
+typedef struct _ProbeStats
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;         // Divide by count for the mean
+    uint32_t histogram[PROBE_BUCKETS];
+} ProbeStats;
+
+#ifdef PROBE_ENABLE
+
+#include <HAL.h>
+
+extern ProbeStats probeStats[NUM_OF_PROBES];
+
+/*!
+ * \brief This macro starts timing a probe
+ *
+ * \param start is the name of the local that keeps the start count
+ */
+#define PROBE_BEGIN(start)      const uint32_t start = HAL_readCycleCount()
+
+/*!
+ * \brief This macro stops timing a probe and records the cycles
+ *
+ * \param start is the name given to PROBE_BEGIN
+ * \param probe is the ProbeId to record in
+ */
+#define PROBE_END(start, probe) \
+    Probe_record((probe), HAL_readCycleCount() - (start))
+
+/*!
+ * \brief This function starts the DWT cycle counter and clears the probes
+ *
+ * \return None
+ */
+extern void Probe_init(void);
+
+/*!
+ * \brief This function adds a measurement to a probe
+ *
+ * This function can be called from interrupts.
+ *
+ * \param probe is the ProbeId
+ * \param cycles is the number of cycles measured
+ *
+ * \return None
+ */
+extern void Probe_record(ProbeId probe, uint32_t cycles);
+
+/*!
+ * \brief This function clears the measurements of every probe
+ *
+ * \return None
+ */
+extern void Probe_reset(void);
+
+#else
+
+#define PROBE_BEGIN(start)                                          ((void) 0)
+#define PROBE_END(start, probe)                                     ((void) 0)
+#define Probe_init()                                                ((void) 0)
+#define Probe_reset()                                               ((void) 0)
+
+#endif /* PROBE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROBE_H_ */
@@ -0,0 +1,158 @@
+/*
+ * Profile.c
+ *
+ * Description: Helper file for the statistical profiler, only built with
+ *              PROFILE_ENABLE. The handler of Timer32_1 is a few instructions
+ *              of assembly that load the PC from the exception frame and
+ *              branch to Profile_sample, which returns from the interrupt.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Profile.h>
+
+#ifdef PROFILE_ENABLE
+
+/* Standard Includes */
+#include <string.h>
+
+#include <Clock.h>
+#include <HAL.h>
+#include <Power.h>
+#include <Telemetry.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* The MSP432 has 3 priority bits, the top ones of the byte */
+#define PROFILE_PRIORITY                                            0x00
+#define OTHER_PRIORITY                                              0x20
+#define SLOT_MASK                                       (PROFILE_SLOTS - 1)
+/* 2^32 / golden ratio, spreads nearby PCs over the table */
+#define HASH_MULTIPLIER                                             2654435761u
+
+Profile profile;
+
+/*!
+ * \brief This function keeps the sample rate when MCLK changes
+ *
+ * \param oldMCLK is the MCLK frequency before the change in Hz
+ * \param newMCLK is the MCLK frequency after the change in Hz
+ *
+ * \return None
+ */
+void Profile_clockChanged(uint32_t oldMCLK, uint32_t newMCLK)
+{
+    if (profile.hz)
+    {
+        Timer32_setCount(TIMER32_1_BASE, newMCLK / profile.hz);
+    }
+}
+
+void Profile_init(void)
+{
+    int interrupt;
+    for (interrupt = FAULT_PENDSV; interrupt <= INT_PORT6; interrupt++)
+    {
+        Interrupt_setPriority(interrupt, OTHER_PRIORITY);
+    }
+    Interrupt_setPriority(INT_T32_INT2, PROFILE_PRIORITY);
+    Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT,
+    TIMER32_PERIODIC_MODE);
+    Timer32_enableInterrupt(TIMER32_1_BASE);
+    Interrupt_enableInterrupt(INT_T32_INT2);
+    Clock_listen(CLOCK_PROFILER, Profile_clockChanged);
+}
+
+void Profile_start(uint32_t hz)
+{
+    Profile_stop();
+    memset(&profile, 0, sizeof(profile));
+    profile.hz = hz;
+    profile.magic = PROFILE_MAGIC;
+    Timer32_setCount(TIMER32_1_BASE, Clock_getMCLK() / hz);
+    Timer32_startTimer(TIMER32_1_BASE, false);
+}
+
+void Profile_stop(void)
+{
+    Timer32_haltTimer(TIMER32_1_BASE);
+    Timer32_clearInterruptFlag(TIMER32_1_BASE);
+}
+
+void Profile_send(void)
+{
+    Telemetry_logBlock(TELEMETRY_PROFILE, &profile, sizeof(profile));
+}
+
+void Profile_sample(uint32_t pc)
+{
+    Timer32_clearInterruptFlag(TIMER32_1_BASE);
+    profile.samples++;
+    if (Power_isAsleep())
+    {
+        profile.asleep++;
+        return;
+    }
+    // Thumb instructions are halfword aligned, so bit 0 is always clear
+    const uint32_t first = (pc >> 1) * HASH_MULTIPLIER
+            >> (32 - PROFILE_SLOT_BITS);
+    uint32_t probe;
+    for (probe = 0; probe < PROFILE_MAX_PROBES; probe++)
+    {
+        ProfileSlot *slot = &profile.slots[(first + probe) & SLOT_MASK];
+        if (slot->count == 0)
+        {
+            slot->pc = pc;
+        }
+        if (slot->pc == pc)
+        {
+            slot->count++;
+            return;
+        }
+    }
+    profile.dropped++;
+}
+
+/*
+ * The handler can't be C, the compiler pushes registers before the body
+ * runs, so the exception frame is at an offset only it knows. The PC is the
+ * 7th word of the frame, on the stack LR says the interrupt used.
+ */
+#if defined(__TI_COMPILER_VERSION__)
+__asm("\t.sect \".text:T32_INT2_IRQHandler\"");
+__asm("\t.thumb");
+__asm("\t.global T32_INT2_IRQHandler");
+__asm("\t.global Profile_sample");
+__asm("T32_INT2_IRQHandler: .asmfunc");
+__asm("\tTST LR, #4");
+__asm("\tITE EQ");
+__asm("\tMRSEQ R0, MSP");
+__asm("\tMRSNE R0, PSP");
+__asm("\tLDR R0, [R0, #24]");
+__asm("\tB Profile_sample");
+__asm("\t.endasmfunc");
+#elif defined(HAL_HOST)
+/*!
+ * \brief This function handles the interrupt of Timer32_1
+ *
+ * The simulated board has no exception frame, host/HostCore.c finds the
+ * interrupted firmware code on the host stack.
+ *
+ * \return None
+ */
+void T32_INT2_IRQHandler(void)
+{
+    Profile_sample(HAL_readInterruptedPC());
+}
+#elif defined(__GNUC__)
+__attribute__ ((naked)) void T32_INT2_IRQHandler(void)
+{
+    __asm volatile("tst lr, #4\n\t"
+                   "ite eq\n\t"
+                   "mrseq r0, msp\n\t"
+                   "mrsne r0, psp\n\t"
+                   "ldr r0, [r0, #24]\n\t"
+                   "b Profile_sample\n\t");
+}
+#endif
+
+#endif /* PROFILE_ENABLE */
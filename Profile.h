@@ -0,0 +1,129 @@
+/*
+ * Profile.h
+ *
+ * Description: Header file for the statistical profiler. Timer32_1 interrupts
+ *              PROFILE_HZ times a second at a higher priority than every
+ *              other interrupt, and its handler counts the PC it interrupted
+ *              in a table in RAM, readable from the debugger as profile. Over
+ *              a game the counts show where the time goes, in handlers too,
+ *              without instrumenting anything. Code that runs with interrupts
+ *              masked is counted at the PC where they are enabled again.
+ *              Samples that woke the CPU from LPM0 are only counted as
+ *              asleep, their PC is always where Power_sleep unmasks.
+ *
+ *              The table is sent on the telemetry channel at the end of the
+ *              game, see Profile_send. host/HostProfile.c turns it into the
+ *              share of the samples of each function, using the map file or
+ *              the symbols of the .out.
+ *
+ *              The profiler is only built when PROFILE_ENABLE is defined,
+ *              otherwise every function here expands to nothing.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+
+/* Samples a second, can be set on the command line */
+#ifndef PROFILE_HZ
+#define PROFILE_HZ                                                  1000
+#endif
+#define PROFILE_MAGIC                                               0x464F5250
+/* Distinct PCs the table holds is 2^PROFILE_SLOT_BITS */
+#define PROFILE_SLOT_BITS                                           9
+#define PROFILE_SLOTS                               (1 << PROFILE_SLOT_BITS)
+/* Slots tried before a sample is dropped */
+#define PROFILE_MAX_PROBES                                          16
+
+typedef struct _ProfileSlot
+{
+    uint32_t pc;            // Address of the interrupted instruction
+    uint32_t count;         // Samples at it, 0 if the slot is free
+} ProfileSlot;
+
+/* The profile, laid out the same in RAM and in a dump of it */
+typedef struct _Profile
+{
+    uint32_t magic;         // PROFILE_MAGIC once sampling started
+    uint32_t hz;            // Samples a second
+    uint32_t samples;       // Samples taken, including dropped ones
+    uint32_t dropped;       // Samples that found no free slot
+    uint32_t asleep;        // Samples taken while the CPU was in LPM0
+    ProfileSlot slots[PROFILE_SLOTS];
+} Profile;
+
+#ifdef PROFILE_ENABLE
+
+/* The samples so far, also readable from the debugger */
+extern Profile profile;
+
+/*!
+ * \brief This function sets up Timer32_1 and the interrupt priorities
+ *
+ * Every other interrupt is moved down one priority level, so only the
+ * profiler interrupt can preempt a handler.
+ *
+ * \return None
+ */
+extern void Profile_init(void);
+
+/*!
+ * \brief This function clears the profile and starts sampling
+ *
+ * \param hz is the number of samples a second, up to MCLK / 100
+ *
+ * \return None
+ */
+extern void Profile_start(uint32_t hz);
+
+/*!
+ * \brief This function stops sampling
+ *
+ * \return None
+ */
+extern void Profile_stop(void);
+
+/*!
+ * \brief This function sends the profile on the telemetry channel
+ *
+ * The profile is sent as TELEMETRY_PROFILE records, 4 bytes of profile per
+ * record. Sampling should be stopped first.
+ *
+ * \return None
+ */
+extern void Profile_send(void);
+
+/*!
+ * \brief This function counts a sample
+ *
+ * This function is called by the Timer32_1 handler.
+ *
+ * \param pc is the address of the interrupted instruction
+ *
+ * \return None
+ */
+extern void Profile_sample(uint32_t pc);
+
+#else
+
+#define Profile_init()                                              ((void) 0)
+#define Profile_start(hz)                                           ((void) 0)
+#define Profile_stop()                                              ((void) 0)
+#define Profile_send()                                              ((void) 0)
+
+#endif /* PROFILE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROFILE_H_ */
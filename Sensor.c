@@ -0,0 +1,88 @@
+/*
+ * Sensor.c
+ *
+ * Description: Helper file for the sensor snapshots
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Sensor.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/*
+ * The seqlock count is odd while a snapshot is being written. Only the ADC
+ * interrupt writes, so a reader that sees the same even count before and
+ * after its copy got a whole snapshot.
+ */
+typedef struct _SensorSlot
+{
+    volatile uint32_t lock;
+    volatile uint16_t raw;
+    volatile uint16_t value;
+    volatile uint32_t sequence;
+    volatile uint32_t timestamp;
+} SensorSlot;
+
+static SensorSlot slots[NUM_OF_SENSORS];
+static SensorFilter filters[NUM_OF_SENSORS];
+
+void Sensor_init(void)
+{
+    // The pot moves quickly, the thermistor and photoresistor drift
+    Filter_init(&filters[SENSOR_POT], FILTER_IIR, Q15(0.5));
+    Filter_init(&filters[SENSOR_THERM], FILTER_AVERAGE, 8);
+    Filter_init(&filters[SENSOR_PHOTO], FILTER_AVERAGE, 4);
+}
+
+void Sensor_restart(int sensor)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    Filter_init(&filters[sensor], filters[sensor].mode, filters[sensor].param);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+void Sensor_publish(int sensor, uint16_t sample, uint32_t timestamp)
+{
+    SensorSlot *slot = &slots[sensor];
+    uint16_t value = Filter_update(&filters[sensor], sample);
+    slot->lock++;
+    slot->raw = sample;
+    slot->value = value;
+    slot->sequence++;
+    slot->timestamp = timestamp;
+    slot->lock++;
+}
+
+bool Sensor_read(int sensor, SensorReading *reading)
+{
+    const SensorSlot *slot = &slots[sensor];
+    uint32_t lock;
+    do
+    {
+        lock = slot->lock;
+        reading->raw = slot->raw;
+        reading->value = slot->value;
+        reading->sequence = slot->sequence;
+        reading->timestamp = slot->timestamp;
+    }
+    while ((lock & 1) || lock != slot->lock);
+    return reading->sequence != 0;
+}
+
+uint32_t Sensor_sequence(int sensor)
+{
+    return slots[sensor].sequence;
+}
+
+void Sensor_setFilter(int sensor, FilterMode mode, int32_t param)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    Filter_init(&filters[sensor], mode, param);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Sensor.h
+ *
+ * Description: Header file for the sensor snapshots. The ADC interrupt
+ *              publishes every sample of the potentiometer, thermistor and
+ *              photoresistor here. Each channel keeps its latest raw and
+ *              filtered reading with a sequence number and timestamp, behind
+ *              a seqlock so a reader never sees half of an update.
+ *
+ *  Created on: Mar 4, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef SENSOR_H_
+#define SENSOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <Filter.h>
+
+/* Sensor channels, the same as the ADC channels */
+#define SENSOR_POT                                                  0
+#define SENSOR_THERM                                                1
+#define SENSOR_PHOTO                                                2
+#define NUM_OF_SENSORS                                              3
+
+typedef struct _SensorReading
+{
+    uint16_t raw;       // Newest 14-bit sample
+    uint16_t value;     // Newest filtered 14-bit sample
+    uint32_t sequence;  // Number of samples published, 0 if none yet
+    uint32_t timestamp; // Timebase time the sample's block arrived
+} SensorReading;
+
+/*!
+ * \brief This function initializes the sensor snapshots
+ *
+ * This function sets the default filters: the potentiometer uses an IIR with
+ * a coefficient of 0.5, the thermistor averages 8 samples and the
+ * photoresistor averages 4.
+ *
+ * \return None
+ */
+extern void Sensor_init(void);
+
+/*!
+ * \brief This function restarts the filter of a sensor
+ *
+ * This function is used when a sensor hasn't been sampled for a while, so old
+ * samples don't lag the new ones. The filter fills from the next sample.
+ *
+ * \param sensor is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return None
+ */
+extern void Sensor_restart(int sensor);
+
+/*!
+ * \brief This function publishes a new sample
+ *
+ * This function is called by the ADC interrupt. The sample is filtered and
+ * becomes the channel's snapshot.
+ *
+ * \param sensor is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ * \param sample is the new 14-bit sample
+ * \param timestamp is the Timebase time the sample arrived
+ *
+ * \return None
+ */
+extern void Sensor_publish(int sensor, uint16_t sample, uint32_t timestamp);
+
+/*!
+ * \brief This function reads the snapshot of a sensor
+ *
+ * This function copies the snapshot without disabling interrupts. If a sample
+ * is published during the copy, the copy is retried.
+ *
+ * \param sensor is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ * \param reading is where the snapshot is copied
+ *
+ * \return true if at least one sample has been published
+ */
+extern bool Sensor_read(int sensor, SensorReading *reading);
+
+/*!
+ * \brief This function gets the sequence number of a sensor
+ *
+ * This function is a cheap way to tell whether a new sample arrived since the
+ * last Sensor_read.
+ *
+ * \param sensor is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return the number of samples published
+ */
+extern uint32_t Sensor_sequence(int sensor);
+
+/*!
+ * \brief This function changes the filter of a sensor
+ *
+ * The filter restarts from the next sample.
+ *
+ * \param sensor is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ * \param mode is the type of filter, see Filter_init
+ * \param param is the length or Q15 coefficient, see Filter_init
+ *
+ * \return None
+ */
+extern void Sensor_setFilter(int sensor, FilterMode mode, int32_t param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_H_ */
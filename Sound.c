@@ -0,0 +1,172 @@
+/*
+ * Sound.c
+ *
+ * Description: Helper file for the tone sequencer on the buzzer
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Sound.h>
+#include <Clock.h>
+#include <Tick.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* CCR0 that toggles the output at twice the frequency, TimerA0 counts SMCLK */
+#define PITCH(hz)                       (CLOCK_SMCLK_HZ / 2 / (hz) - 1)
+/* CCR0 of 0 stops TimerA0 in up mode */
+#define SILENCE                                                     0
+
+/* Priorities of the melodies */
+#define SOUND_BACKGROUND                                            0
+#define SOUND_JINGLE                                                1
+#define SOUND_URGENT                                                2
+/* Never cut off, the game ends with it */
+#define SOUND_FINAL                                                 3
+
+typedef struct _Note
+{
+    uint16_t pitch;         // CCR0, PITCH(hz)
+    uint16_t ms;            // Length of the tone at SOUND_TEMPO
+    uint16_t rest;          // Silence after the tone at SOUND_TEMPO
+} Note;
+
+typedef struct _Melody
+{
+    const Note *notes;
+    uint8_t length;
+    uint8_t priority;
+} Melody;
+
+static const Note countdownNotes[] = {
+        { PITCH(1500), 1000, 0 } };
+static const Note taskDoneNotes[] = {
+        { PITCH(1047), 70, 20 }, { PITCH(1319), 70, 20 },
+        { PITCH(1568), 70, 20 }, { PITCH(2093), 180, 0 } };
+static const Note penaltyNotes[] = {
+        { PITCH(784), 120, 40 }, { PITCH(523), 300, 0 } };
+static const Note firedNotes[] = {
+        { PITCH(784), 250, 50 }, { PITCH(698), 250, 50 },
+        { PITCH(659), 250, 50 }, { PITCH(523), 700, 0 } };
+
+/* Indexed by SoundMelody */
+static const Melody melodies[NUM_OF_SOUND_MELODIES] = {
+        { countdownNotes, 1, SOUND_BACKGROUND },
+        { countdownNotes, 1, SOUND_URGENT },
+        { taskDoneNotes, 4, SOUND_JINGLE },
+        { penaltyNotes, 2, SOUND_JINGLE },
+        { firedNotes, 4, SOUND_FINAL } };
+
+/* The melody playing, 0 while the buzzer is silent */
+static const Melody *playing = 0;
+static uint8_t noteIndex;
+static bool resting;
+static uint16_t playTempo;
+static Sound_Callback onEnd;
+static TickTimer noteTimer;
+
+/*!
+ * \brief This function scales a note length by the tempo
+ *
+ * \param ms is the length at SOUND_TEMPO
+ *
+ * \return the length in ms
+ */
+uint32_t Sound_scale(uint16_t ms)
+{
+    return (uint32_t) ms * playTempo / SOUND_TEMPO;
+}
+
+/*!
+ * \brief This function plays the next tone or rest of the melody
+ *
+ * This function is run by noteTimer at the end of each tone and rest. A note
+ * change is one write of CCR0. Once the melody is over the buzzer is silenced
+ * and the callback runs.
+ *
+ * \return None
+ */
+void Sound_advance(void)
+{
+    const Note *note = &playing->notes[noteIndex];
+    if (!resting && note->rest)
+    {
+        Timer_A_setCompareValue(TIMER_A0_BASE,
+        TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                                SILENCE);
+        resting = true;
+        Tick_start(&noteTimer, Sound_scale(note->rest), 0, Sound_advance);
+        return;
+    }
+    if (++noteIndex == playing->length)
+    {
+        Timer_A_setCompareValue(TIMER_A0_BASE,
+        TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                                SILENCE);
+        playing = 0;
+        if (onEnd)
+        {
+            onEnd();
+        }
+        return;
+    }
+    note++;
+    Timer_A_setCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                            note->pitch);
+    resting = false;
+    Tick_start(&noteTimer, Sound_scale(note->ms), 0, Sound_advance);
+}
+
+void Sound_init(void)
+{
+    GPIO_setAsPeripheralModuleFunctionOutputPin(GPIO_PORT_P2,
+    GPIO_PIN6,
+                                                GPIO_PRIMARY_MODULE_FUNCTION);
+    // The only full configuration, after this a note is a CCR0 write
+    const Timer_A_PWMConfig compareConfig_PWM = {
+            TIMER_A_CLOCKSOURCE_SMCLK,
+            TIMER_A_CLOCKSOURCE_DIVIDER_1,
+            SILENCE,
+            TIMER_A_CAPTURECOMPARE_REGISTER_0,
+            TIMER_A_OUTPUTMODE_TOGGLE, 0 };
+    Timer_A_generatePWM(TIMER_A0_BASE, &compareConfig_PWM);
+}
+
+bool Sound_play(SoundMelody melody, uint16_t tempo, Sound_Callback callback)
+{
+    const Melody *next = &melodies[melody];
+    bool wasDisabled = Interrupt_disableMaster();
+    const bool start = !playing
+            || (playing->priority != SOUND_FINAL
+                    && playing->priority <= next->priority);
+    if (start)
+    {
+        playing = next;
+        noteIndex = 0;
+        resting = false;
+        playTempo = tempo;
+        onEnd = callback;
+        Timer_A_setCompareValue(TIMER_A0_BASE,
+        TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                                next->notes[0].pitch);
+        Tick_start(&noteTimer, Sound_scale(next->notes[0].ms), 0,
+                   Sound_advance);
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return start;
+}
+
+void Sound_stop(void)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    Tick_cancel(&noteTimer);
+    playing = 0;
+    Timer_A_setCompareValue(TIMER_A0_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                            SILENCE);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Sound.h
+ *
+ * Description: Header file for the tone sequencer on the buzzer. A melody is
+ *              a table of notes in flash, each a pitch, a length and a rest.
+ *              TimerA0 toggles P2.6 at the pitch, so changing a note is one
+ *              write of CCR0, and a software timer on the millisecond tick
+ *              moves on to the next note. Nothing waits for a melody to end.
+ *
+ *              Every melody has a priority. A melody only cuts off one of
+ *              the same or a lower priority, so the jingles win over the
+ *              countdown beeps, which go on after them. In the last seconds
+ *              the countdown beeps as SOUND_HURRY instead, which wins over
+ *              the jingles. SOUND_FIRED is never cut off.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef SOUND_H_
+#define SOUND_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Tempo a melody is written at, note lengths are scaled by tempo / 1000 */
+#define SOUND_TEMPO                                                 1000
+
+typedef enum _SoundMelody
+{
+    SOUND_COUNTDOWN,        // One beep, its length is the tempo in ms
+    SOUND_HURRY,            // The same beep, cuts off the jingles
+    SOUND_TASK_DONE,
+    SOUND_PENALTY,
+    SOUND_FIRED,
+    NUM_OF_SOUND_MELODIES
+} SoundMelody;
+
+typedef void (*Sound_Callback)(void);
+
+/*!
+ * \brief This function initializes the buzzer
+ *
+ * This function sets P2.6 as the TA0.0 output and starts TimerA0 on SMCLK,
+ * silent. Tick_init must be called first.
+ *
+ * \return None
+ */
+extern void Sound_init(void);
+
+/*!
+ * \brief This function starts playing a melody
+ *
+ * This function is safe to call from interrupts and callbacks. The melody
+ * replaces the one playing unless that one has a higher priority or is
+ * SOUND_FIRED. The callback of the melody replaced won't run.
+ *
+ * \param melody is the SoundMelody to play
+ * \param tempo is the length of a written 1000 ms in ms, SOUND_TEMPO to play
+ *          the melody as written
+ * \param callback is the function to call from PendSV once the melody ended,
+ *          or 0
+ *
+ * \return true if the melody started, false if a higher priority one plays
+ */
+extern bool Sound_play(SoundMelody melody, uint16_t tempo,
+                       Sound_Callback callback);
+
+/*!
+ * \brief This function silences the buzzer
+ *
+ * The melody playing is dropped and its callback won't run.
+ *
+ * \return None
+ */
+extern void Sound_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOUND_H_ */
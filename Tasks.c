@@ -14,7 +14,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
 
 // Other includes
@@ -23,7 +22,74 @@
 #include "outputs.h"
 #include "delays.h"
 #include "Timer.h"
+#include "Timebase.h"
+#include "Tick.h"
+#include "Sound.h"
+#include "Motion.h"
 #include "Tasks.h"
+#include "Sensor.h"
+#include "Format.h"
+#include "Telemetry.h"
+#include "Trace.h"
+
+#define SAMPLE_PERIOD                                      TIMEBASE_MS(100)
+#define OVERSHOOT_PAUSE                                    TIMEBASE_MS(200)
+// Counts per 10 degrees of the pot
+#define ANGLE_STEP                                                  910
+#define ANGLE_HYSTERESIS                                            150
+// Top speed of the servo in degrees per second
+#define SERVO_SPEED                                                 240
+// 3.3 V full scale of the ADC in Q16
+#define FULL_SCALE_VOLTS_Q16                                        216269
+// Power is shown in 10 mV steps
+#define MILLIVOLT_STEP                                              10
+#define MILLIVOLT_HYSTERESIS                                        3
+
+/* State shared by whichever task is running, only one runs at a time */
+static int taskDifficulty;
+static int taskSensor;
+static int taskValue;
+static uint32_t lastSample;
+
+/* Password task */
+static char password[8];
+static int passwordLength;
+static int passwordIndex;
+
+/* Lights, Temp, Direction and Power tasks */
+static int target;
+static bool targetSet;
+static bool lessThan;
+static uint32_t pausedUntil;
+static uint32_t analogTarget;    // Power target in volts, Q16
+static Quantizer analogBuckets;
+
+/* Reaction task */
+typedef enum _ReactionPhase
+{
+    LEDOn, LEDOff
+} ReactionPhase;
+/* When an LED was lit, kept for judging presses after the fact */
+typedef struct _ReactionWindow
+{
+    int led;
+    uint32_t on;            // Timebase ticks when it turned on
+    uint32_t off;           // Timebase ticks when it turned off
+    bool lit;               // Still on, off isn't set yet
+} ReactionWindow;
+/* On/off times in ms for Easy, Medium and Hard */
+static const uint16_t reactionOnMs[3] = { 500, 300, 250 };
+static const uint16_t reactionOffMs[3] = { 300, 200, 100 };
+static int reactionLED;
+static volatile ReactionPhase reactionPhase;
+static ReactionStats reactionStats;
+/* The current window and the one before, written by the blink callback */
+static volatile ReactionWindow reactionWindows[2];
+static volatile uint8_t reactionLatest;
+static TickTimer reactionTimer;
+
+/* Binary task */
+static int binaryValue;
 
 /*!
  * \brief This function decrements the game timer
@@ -41,21 +107,85 @@
  */
 void decrementTimer(int difficulty)
 {
-    Timer32_setCount(
-            TIMER32_0_BASE,
-            Timer32_getValue(TIMER32_0_BASE) - CS_getMCLK() * (1 + difficulty));
+    Timer_penalize(1000 * (1 + difficulty));
+    Sound_play(SOUND_PENALTY, SOUND_TEMPO, 0);
+    Telemetry_log(TELEMETRY_PENALTY, 1 + difficulty);
+    Trace_record(TRACE_PENALTY, 1 + difficulty);
+}
+
+/*!
+ * \brief This function checks for new presses of the button
+ *
+ * This function takes the queued switch events and reports whether any of
+ * them was a button press, so holding the button or a bounce only counts
+ * once. Events of the other switches are discarded.
+ *
+ * \return true if the button was pressed since the last call
+ */
+bool buttonPressed(void)
+{
+    SwitchEvent event;
+    bool pressed = false;
+    while (switch_poll(&event))
+    {
+        if (event.pin == 5 && event.pressed)
+        {
+            pressed = true;
+        }
+    }
+    return pressed;
+}
+
+/*!
+ * \brief This function checks whether a sample period has passed
+ *
+ * This function is used by the analog tasks to act on the potentiometer,
+ * thermistor and photoresistor every 100 ms. When the period has passed,
+ * taskValue is updated from the snapshot of the task's sensor.
+ *
+ * \return true if the task should sample now
+ */
+bool sampleDue(void)
+{
+    uint32_t now = Timebase_now();
+    SensorReading reading;
+    if (now - lastSample < SAMPLE_PERIOD || !Sensor_read(taskSensor, &reading))
+    {
+        return false;
+    }
+    lastSample = now;
+    taskValue = reading.value;
+    return true;
 }
 
-void taskPassword(int difficulty)
+/*!
+ * \brief This function starts the sample period of an analog task
+ *
+ * \param difficulty is the difficulty the game is running at
+ * \param sensor is the sensor the task reads
+ *
+ * \return true if the sensor had a reading for taskValue
+ */
+bool startSampling(int difficulty, int sensor)
 {
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    const int length = 4 + difficulty;
+    SensorReading reading;
+    taskDifficulty = difficulty;
+    taskSensor = sensor;
+    bool valid = Sensor_read(sensor, &reading);
+    taskValue = reading.value;
+    lastSample = Timebase_now();
+    return valid;
+}
 
-    char *password = malloc(length);
+void taskPassword_start(int difficulty)
+{
+    clearFrame();
+    taskDifficulty = difficulty;
+    passwordLength = 4 + difficulty;
+    passwordIndex = 0;
 
     int i;
-    for (i = 0; i < length; i++)
+    for (i = 0; i < passwordLength; i++)
     {
         // generate random password, exclude '#' and '*'
         int row;
@@ -69,311 +199,458 @@ void taskPassword(int difficulty)
         password[i] = keypad_map[row][col];
     }
 
-    printString("Enter password:", 15);
+    setFrameString(0, 0, "Enter password:", 15);
+    setFrameString(1, 0, password, passwordLength);
+}
 
-    commandInstruction(SET_CURSOR_MASK | LINE2_OFFSET, false);
-    printString(password, length);
-    for (i = length; i < 8; i++)
-        printChar(' ');
+bool taskPassword_step(void)
+{
+    KeypadEvent event;
     // Enter password, must enter correct char to progress
-    for (i = 0; i < length; i++)
+    while (passwordIndex < passwordLength && keypad_poll(&event))
     {
-        while (password[i] != keypad_get_input())
+        if (!event.pressed)
+        {
+            continue;
+        }
+        if (event.key != password[passwordIndex])
         {
-            decrementTimer(difficulty);
+            decrementTimer(taskDifficulty);
+            continue;
         }
-        printChar(password[i]);
+        setFrameChar(1, 8 + passwordIndex, password[passwordIndex]);
+        passwordIndex++;
     }
+    return passwordIndex == passwordLength;
 }
 
-void taskLights(int difficulty, int *digitalValue)
+void taskLights_start(int difficulty)
 {
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    ADC14_toggleConversionTrigger();
-    int target = 16000 - 300 * (3 - difficulty);
+    clearFrame();
+    startSampling(difficulty, SENSOR_PHOTO);
+    target = 16000 - 300 * (3 - difficulty);
+    // Wakes the task once a sample reaches the target
+    ADC_armWindow(SENSOR_PHOTO, 0, target - 1);
 
-    printString("Turn off the\nlights", 19);
+    setFrameString(0, 0, "Turn off the\nlights", 19);
+}
 
-    while (*digitalValue < target)
+bool taskLights_step(void)
+{
+    SensorReading reading;
+    if (!ADC_windowCrossed(SENSOR_PHOTO))
+    {
+        return false;
+    }
+    Sensor_read(SENSOR_PHOTO, &reading);
+    if (reading.value < target)
     {
-        ADC14_toggleConversionTrigger();
-        delayMilliSec(100);
+        // One raw sample crossed, wait for the filtered reading to follow
+        ADC_armWindow(SENSOR_PHOTO, 0, target - 1);
+        return false;
     }
+    ADC_disarmWindow(SENSOR_PHOTO);
+    return true;
+}
 
+/*!
+ * \brief This function arms the window of the Temperature task
+ *
+ * The target is 350 counts below the current reading, the thermistor reads
+ * lower as it heats up.
+ *
+ * \return None
+ */
+void taskTemp_setTarget(void)
+{
+    target = taskValue - 350;
+    targetSet = true;
+    // Wakes the task once a sample reaches the target
+    ADC_armWindow(SENSOR_THERM, target + 1, ADC_WINDOW_MAX);
 }
 
-void taskTemp(int difficulty, int *digitalValue)
+void taskTemp_start(int difficulty)
 {
-    ADC14_toggleConversionTrigger();
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    printString("Turn up the\nheat", 17);
+    clearFrame();
+    targetSet = false;
+    if (startSampling(difficulty, SENSOR_THERM))
+    {
+        taskTemp_setTarget();
+    }
+
+    setFrameString(0, 0, "Turn up the\nheat", 17);
+}
 
-    int target = *digitalValue - 350;
-    while (*digitalValue > target)
+bool taskTemp_step(void)
+{
+    SensorReading reading;
+    if (!targetSet)
+    {
+        // No reading yet, the target is set from the first one
+        if (sampleDue())
+        {
+            taskTemp_setTarget();
+        }
+        return false;
+    }
+    if (!ADC_windowCrossed(SENSOR_THERM))
     {
-        ADC14_toggleConversionTrigger();
-        delayMilliSec(100);
+        return false;
     }
+    Sensor_read(SENSOR_THERM, &reading);
+    if (reading.value > target)
+    {
+        // One raw sample crossed, wait for the filtered reading to follow
+        ADC_armWindow(SENSOR_THERM, target + 1, ADC_WINDOW_MAX);
+        return false;
+    }
+    ADC_disarmWindow(SENSOR_THERM);
+    return true;
+}
 
+/*!
+ * \brief This function displays an angle of the Direction task
+ *
+ * The angle is shown as a label, a colon, three digits and a degree sign.
+ *
+ * \param col is the column to start at
+ * \param label is the letter in front of the angle
+ * \param angle is the angle in tens of degrees
+ *
+ * \return None
+ */
+void taskDirection_showAngle(int col, char label, int angle)
+{
+    char a[6];
+    a[0] = label;
+    a[1] = ':';
+    Format_uint(a + 2, angle * 10, 3);
+    a[5] = FORMAT_DEGREE;
+    setFrameString(1, col, a, 6);
 }
 
-void taskDirection(int difficulty, int *digitalValue)
+void taskDirection_start(int difficulty)
 {
-    ADC14_toggleConversionTrigger();
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    printString("Set direction to\n", 17);
+    clearFrame();
+    startSampling(difficulty, SENSOR_POT);
+    setFrameString(0, 0, "Set direction to", 16);
     // Set angle based on current pot position for maximum interaction
-    bool lt = *digitalValue < 7280;
-    int targetAngle = (lt ? 7280 + rand() % 7280 : 7280 - rand() % 7280) / 910;
-    int currentAngle = *digitalValue / 910;
-    char t[5];
-    sprintf(t, "T:%i0", targetAngle);
+    lessThan = taskValue < 7280;
+    target = (lessThan ? 7280 + rand() % 7280 : 7280 - rand() % 7280)
+            / ANGLE_STEP;
+    pausedUntil = lastSample;
+    Quantizer_init(&analogBuckets, ANGLE_STEP, ANGLE_HYSTERESIS, taskValue);
+    Motion_moveTo(analogBuckets.bucket * 10, SERVO_SPEED, 0);
+    taskDirection_showAngle(0, 'T', target);
+    taskDirection_showAngle(7, 'C', analogBuckets.bucket);
+}
 
-    while (targetAngle != currentAngle)
+bool taskDirection_step(void)
+{
+    // Hold off after an overshoot so one mistake costs one penalty
+    if ((int32_t) (Timebase_now() - pausedUntil) < 0 || !sampleDue())
     {
-        // Adjust servo, poll value, update LCD
-        Servo_setAngle(*digitalValue);
-        currentAngle = *digitalValue / 910;
-        commandInstruction(SET_CURSOR_MASK | LINE2_OFFSET, false);
-        char a[5];
-        sprintf(a, "C:%i0", currentAngle);
-        printString(t, 5);
-        printChar(0b11011111); // Degree sign
-        printString(a, 5);
-        printChar(0b11011111);
-        // check for overshoot
-        if (lt && currentAngle > targetAngle)
-        {
-            decrementTimer(difficulty);
-            delayMilliSec(200);
-        }
-        else if (!lt && currentAngle < targetAngle)
-        {
-            decrementTimer(difficulty);
-            delayMilliSec(200);
-        }
+        return false;
+    }
+
+    // Adjust servo and update LCD only when the angle changes
+    if (Quantizer_update(&analogBuckets, taskValue))
+    {
+        Motion_moveTo(analogBuckets.bucket * 10, SERVO_SPEED, 0);
+        taskDirection_showAngle(7, 'C', analogBuckets.bucket);
+    }
+    int currentAngle = analogBuckets.bucket;
+    if (currentAngle == target)
+    {
+        return true;
+    }
 
-        ADC14_toggleConversionTrigger();
-        delayMilliSec(100);
+    // check for overshoot
+    if ((lessThan && currentAngle > target)
+            || (!lessThan && currentAngle < target))
+    {
+        decrementTimer(taskDifficulty);
+        pausedUntil = Timebase_now() + OVERSHOOT_PAUSE;
     }
+    return false;
+}
+
+/*!
+ * \brief This function converts a pot sample into millivolts
+ *
+ * \param value is the 14-bit sample
+ *
+ * \return value in millivolts
+ */
+int taskDivertPower_millivolts(int value)
+{
+    return value * 3300 / 16384;
+}
+
+/*!
+ * \brief This function displays the target and current power
+ *
+ * \return None
+ */
+void taskDivertPower_show(void)
+{
+    // T:3.30V C:1.65V
+    char a[15];
+    a[0] = 'T';
+    a[1] = ':';
+    Format_q(a + 2, analogTarget, 16, 2, 4);
+    a[6] = 'V';
+    a[7] = ' ';
+    a[8] = 'C';
+    a[9] = ':';
+    Format_fixed(a + 10, analogBuckets.bucket * MILLIVOLT_STEP / 10, 2, 4);
+    a[14] = 'V';
+    setFrameString(1, 0, a, 15);
 }
 
-void taskDivertPower(int difficulty, int *digitalValue)
+void taskDivertPower_start(int difficulty)
 {
-    ADC14_toggleConversionTrigger();
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
+    clearFrame();
+    startSampling(difficulty, SENSOR_POT);
 
     // randomize target value not near current value
-    int target = rand() % 16384;
-    while ((target < *digitalValue + 2000) && (target > *digitalValue - 2000))
+    target = rand() % 16384;
+    while ((target < taskValue + 2000) && (target > taskValue - 2000))
     {
         target = rand() % 16384;
     }
 
-    bool lt = *digitalValue < target;
-    float analogTarget = (target * 3.3) / 16384;
-    printString("Set power to", 12);
+    lessThan = taskValue < target;
+    analogTarget = ((uint32_t) target * FULL_SCALE_VOLTS_Q16) >> 14;
+    setFrameString(0, 0, "Set power to", 12);
+    Quantizer_init(&analogBuckets, MILLIVOLT_STEP, MILLIVOLT_HYSTERESIS,
+                   taskDivertPower_millivolts(taskValue));
+    taskDivertPower_show();
+}
+
+bool taskDivertPower_step(void)
+{
+    if (!sampleDue())
+    {
+        return false;
+    }
+
+    // poll value, update LCD only when the shown voltage changes
+    int value = taskValue;
+    if (Quantizer_update(&analogBuckets, taskDivertPower_millivolts(value)))
+    {
+        taskDivertPower_show();
+    }
+
+    // Check for overshoot
+    if (lessThan && value - 250 * (3 - taskDifficulty) > target)
+    {
+        decrementTimer(taskDifficulty);
+    }
+    else if (!lessThan && value + 250 * (3 - taskDifficulty) < target)
+    {
+        decrementTimer(taskDifficulty);
+    }
+
+    return (value < target + 50 * (3 - taskDifficulty))
+            && (value > target - 50 * (3 - taskDifficulty));
+}
+
+/*!
+ * \brief This function lights the next LED of the Reaction task
+ *
+ * Easy only blinks the proper LED, Medium blinks it or the opposite LED, and
+ * Hard blinks any LED. The LED and when it turned on start a new window.
+ *
+ * \return None
+ */
+void reactionTurnOn(void)
+{
+    int led;
+    switch (taskDifficulty)
+    {
+    case 0:
+        led = reactionLED;
+        break;
+    case 1:
+        led = rand() % 2 == 1 ? (reactionLED + 2) % 4 : reactionLED;
+        break;
+    default:
+        led = rand() % 4;
+    }
+    External_LED_turnonLED(led);
+    const uint8_t latest = reactionLatest ^ 1;
+    reactionWindows[latest].led = led;
+    reactionWindows[latest].on = Timebase_now();
+    reactionWindows[latest].lit = true;
+    reactionLatest = latest;
+    reactionPhase = LEDOn;
+}
+
+/*!
+ * \brief This function blinks the LEDs of the Reaction task
+ *
+ * This function is run by reactionTimer at the end of each on and off time,
+ * so the blinking doesn't depend on the task loop.
+ *
+ * \return None
+ */
+void reactionBlink(void)
+{
+    if (reactionPhase == LEDOn)
+    {
+        External_LED_turnOff();
+        reactionWindows[reactionLatest].off = Timebase_now();
+        reactionWindows[reactionLatest].lit = false;
+        reactionPhase = LEDOff;
+        Tick_start(&reactionTimer, reactionOffMs[taskDifficulty], 0,
+                   reactionBlink);
+    }
+    else
+    {
+        reactionTurnOn();
+        Tick_start(&reactionTimer, reactionOnMs[taskDifficulty], 0,
+                   reactionBlink);
+    }
+}
 
-    bool complete = false;
-    while (!complete)
+/*!
+ * \brief This function checks whether the proper LED was on at a time
+ *
+ * A button event is read a debounce time after its edge, so the LED may have
+ * changed since. The last two windows cover that, the shortest on or off
+ * time is longer than the debounce.
+ *
+ * \param timestamp is the time of the press in Timebase ticks
+ * \param on is set to when the proper LED turned on, if it was on
+ *
+ * \return true if the proper LED was on
+ */
+bool reactionHit(uint32_t timestamp, uint32_t *on)
+{
+    bool hit = false;
+    bool wasDisabled = Interrupt_disableMaster();
+    int i;
+    for (i = 0; i < 2; i++)
     {
-        // poll value, update LCD
-        float analogValue = (*digitalValue * 3.3) / 16384;
-        commandInstruction(SET_CURSOR_MASK | LINE2_OFFSET, false);
-        char a[16];
-        sprintf(a, "T:%4.2fV C:%4.2fV", analogTarget, analogValue);
-        printString(a, 16);
-
-        // Check for overshoot
-        if (lt && *digitalValue - 250 * (3 - difficulty) > target)
+        const volatile ReactionWindow *window = &reactionWindows[i];
+        if (window->led != reactionLED
+                || (int32_t) (timestamp - window->on) < 0)
         {
-            decrementTimer(difficulty);
+            continue;
         }
-        else if (!lt && *digitalValue + 250 * (3 - difficulty) < target)
+        if (window->lit || timestamp - window->on < window->off - window->on)
         {
-            decrementTimer(difficulty);
+            hit = true;
+            *on = window->on;
         }
-
-        complete = ((*digitalValue < target + 50 * (3 - difficulty))
-                && (*digitalValue > target - 50 * (3 - difficulty)));
-
-        ADC14_toggleConversionTrigger();
-        delayMilliSec(100);
     }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return hit;
 }
 
-void taskReaction(int difficulty)
+void taskReaction_start(int difficulty)
 {
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    printString("Press button\nwhen ", 18);
+    clearFrame();
+    taskDifficulty = difficulty;
+    setFrameString(0, 0, "Press button\nwhen ", 18);
     // Choose random LED
-    const int LED = rand() % 4;
-    switch (LED)
+    reactionLED = rand() % 4;
+    switch (reactionLED)
     {
     case 0:
-        printString("Y LED on", 8);
+        setFrameString(1, 5, "Y LED on", 8);
         break;
     case 1:
-        printString("B LED on", 8);
+        setFrameString(1, 5, "B LED on", 8);
         break;
     case 2:
-        printString("G LED on", 8);
+        setFrameString(1, 5, "G LED on", 8);
         break;
     case 3:
-        printString("R LED on", 8);
+        setFrameString(1, 5, "R LED on", 8);
         break;
     }
+    // Forget presses made before the task started
+    buttonPressed();
+    memset(&reactionStats, 0, sizeof(reactionStats));
+    memset((void*) reactionWindows, 0, sizeof(reactionWindows));
+    // No window matches the proper LED until one is lit
+    reactionWindows[0].led = reactionWindows[1].led = -1;
+    bool wasDisabled = Interrupt_disableMaster();
+    reactionPhase = LEDOff;
+    reactionBlink();
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
 
-    switch (difficulty)
+bool taskReaction_step(void)
+{
+    SwitchEvent event;
+    while (switch_poll(&event))
     {
-    case 0:
-        // Easy, only blink proper LED
-        while (1)
+        if (event.pin != 5 || !event.pressed)
         {
-            External_LED_turnonLED(LED);
-            int i;
-            for (i = 0; i < 50000; i++)
-            {
-                if (switch_pressed(5))
-                {
-                    External_LED_turnOff();
-                    return;
-                }
-            }
-            External_LED_turnOff();
-            for (i = 0; i < 30000; i++)
-            {
-                if (switch_pressed(5))
-                    decrementTimer(difficulty);
-            }
+            continue;
         }
-    case 1:
-    {
-        // Medium, blink two LEDs
-        int other = (LED + 2) % 4;
-        while (1)
+        reactionStats.presses++;
+        uint32_t on;
+        if (reactionHit(event.timestamp, &on))
         {
-            int current = rand() % 2 == 1 ? other : LED;
-            External_LED_turnonLED(current);
-            int i;
-            for (i = 0; i < 30000; i++)
-            {
-                if (switch_pressed(5))
-                {
-                    if (current == LED)
-                    {
-                        External_LED_turnOff();
-                        return;
-                    }
-                    else
-                        decrementTimer(difficulty);
-                }
-            }
+            Tick_cancel(&reactionTimer);
             External_LED_turnOff();
-            for (i = 0; i < 20000; i++)
-            {
-                if (switch_pressed(5))
-                    decrementTimer(difficulty);
-            }
-        }
-    }
-    case 2:
-        // Hard, blink any LED quickly
-        while (1)
-        {
-            int current = rand() % 4;
-            External_LED_turnonLED(current);
-            int i;
-            for (i = 0; i < 25000; i++)
-            {
-                if (switch_pressed(5))
-                {
-                    if (current == LED)
-                    {
-                        External_LED_turnOff();
-                        return;
-                    }
-                    else
-                        decrementTimer(difficulty);
-                }
-            }
-            External_LED_turnOff();
-            for (i = 0; i < 10000; i++)
-            {
-                if (switch_pressed(5))
-                    decrementTimer(difficulty);
-            }
+            // Both ends were timestamped in interrupts, on the same timebase
+            reactionStats.micros = (uint64_t) (event.timestamp - on) * 1000000
+                    / TIMEBASE_HZ;
+            Telemetry_log(TELEMETRY_REACTION, reactionStats.micros);
+            return true;
         }
+        reactionStats.misses++;
+        decrementTimer(taskDifficulty);
     }
+    return false;
+}
+
+void taskReaction_getStats(ReactionStats *stats)
+{
+    *stats = reactionStats;
 }
 
-void taskBinary(int difficulty)
+void taskBinary_start(int difficulty)
 {
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    printString("Press the right\nhex number", 26);
+    clearFrame();
+    taskDifficulty = difficulty;
+    setFrameString(0, 0, "Press the right\nhex number", 26);
 
     // Generate random hex value
-    int val = rand() % 14;
-    External_LED_turnOnHex(val);
+    binaryValue = rand() % 14;
+    External_LED_turnOnHex(binaryValue);
+}
 
-    bool complete = false;
-    while (!complete)
+bool taskBinary_step(void)
+{
+    // Keys for the values 0 - 13
+    const char hexKeys[14] = { '0', '1', '2', '3', '4', '5', '6', '7', '8',
+                               '9', 'A', 'B', 'C', 'D' };
+    KeypadEvent event;
+    while (keypad_poll(&event))
     {
+        if (!event.pressed)
+        {
+            continue;
+        }
         // poll keypad, check if correct
-        char input = keypad_get_input();
-        switch (val)
+        if (event.key == hexKeys[binaryValue])
         {
-        case 0:
-            complete = input == '0';
-            break;
-        case 1:
-            complete = input == '1';
-            break;
-        case 2:
-            complete = input == '2';
-            break;
-        case 3:
-            complete = input == '3';
-            break;
-        case 4:
-            complete = input == '4';
-            break;
-        case 5:
-            complete = input == '5';
-            break;
-        case 6:
-            complete = input == '6';
-            break;
-        case 7:
-            complete = input == '7';
-            break;
-        case 8:
-            complete = input == '8';
-            break;
-        case 9:
-            complete = input == '9';
-            break;
-        case 10:
-            complete = input == 'A';
-            break;
-        case 11:
-            complete = input == 'B';
-            break;
-        case 12:
-            complete = input == 'C';
-            break;
-        case 13:
-            complete = input == 'D';
-            break;
+            External_LED_turnOff();
+            return true;
         }
-        if (!complete)
-            decrementTimer(difficulty);
+        decrementTimer(taskDifficulty);
     }
-    External_LED_turnOff();
+    return false;
 }
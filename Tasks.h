@@ -17,107 +17,196 @@ extern "C" {
 /* DriverLib Includes */
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+typedef struct _ReactionStats
+{
+    uint32_t micros;        // Reaction time of the press that hit, in us
+    uint16_t presses;       // Presses of the button, the hit included
+    uint16_t misses;        // Presses that cost time
+} ReactionStats;
+
+/*
+ * Every task is split into a start function and a step function. The start
+ * function sets up the task and its display. The step function is called by
+ * the event loop in main each time the CPU wakes up. It handles whatever input
+ * arrived, never blocks, and returns true once the task is complete.
+ */
+
 /*!
- * \brief This function handles the Password task
+ * \brief This function starts the Password task
  *
  * This function generates a random password whose length depends on the
- * difficulty. The user then presses buttons on the keypad, if the user enters
- * the password incorrectly, they lose time, if they enter it correctly, they
- * complete the task.
+ * difficulty and displays it.
  *
  * \param difficulty the difficulty the game is running at
  *
  * \return None
  */
-extern void taskPassword(int difficulty);
+extern void taskPassword_start(int difficulty);
 
 /*!
- * \brief This function handles the Lights task
+ * \brief This function runs the Password task
  *
- * This function will tell the user to turn off the lights. The user must
- * decrease the amount of light the photoresistor senses below a threshold to
+ * This function takes the queued keypad presses. If the user enters the
+ * password incorrectly, they lose time, if they enter it correctly, they
  * complete the task.
  *
+ * \return true if the task is complete
+ */
+extern bool taskPassword_step(void);
+
+/*!
+ * \brief This function starts the Lights task
+ *
+ * This function will tell the user to turn off the lights.
+ *
  * \param difficulty the difficulty the game is running at
- * \param *digitalValue is the pointer to the analog input of the photoresistor
  *
  * \return None
  */
-extern void taskLights(int difficulty, int *digitalValue);
+extern void taskLights_start(int difficulty);
 
 /*!
- * \brief This function handles the Temperature task
+ * \brief This function runs the Lights task
  *
- * This function will tell the user to turn up the heat. The user must
- * increase the temperature the thermistor senses above a threshold to complete
- * the task.
+ * The user must decrease the amount of light the photoresistor senses below a
+ * threshold to complete the task. The ADC14 window comparator watches the
+ * photoresistor and wakes the task on the first raw sample past the threshold.
+ * The task completes once the filtered reading is past it too, so one noisy
+ * sample doesn't count.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskLights_step(void);
+
+/*!
+ * \brief This function starts the Temperature task
+ *
+ * This function will tell the user to turn up the heat.
  *
  * \param difficulty the difficulty the game is running at
- * \param *digitalValue is the pointer to the analog input of the thermistor
  *
  * \return None
  */
-extern void taskTemp(int difficulty, int *digitalValue);
+extern void taskTemp_start(int difficulty);
 
 /*!
- * \brief This function handles the Direction task
+ * \brief This function runs the Temperature task
  *
- * This function gives the user an angle to set the servo to. The user adjusts
- * the potentiometer to the desired angle. If they adjust the potentiometer too
- * far or the wrong direction, they lose time, if they set the potentiometer to a
- * correct value, they complete the task.
+ * The user must increase the temperature the thermistor senses above a
+ * threshold to complete the task. The ADC14 window comparator watches the
+ * thermistor and wakes the task on the first raw sample past the threshold.
+ * The task completes once the filtered reading is past it too, so one noisy
+ * sample doesn't count.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskTemp_step(void);
+
+/*!
+ * \brief This function starts the Direction task
+ *
+ * This function gives the user an angle to set the servo to.
  *
  * \param difficulty the difficulty the game is running at
- * \param *digitalValue is the pointer to the analog input of the potentiometer
  *
  * \return None
  */
-extern void taskDirection(int difficulty, int *digitalValue);
+extern void taskDirection_start(int difficulty);
+
+/*!
+ * \brief This function runs the Direction task
+ *
+ * The user adjusts the potentiometer to the desired angle. If they adjust the
+ * potentiometer too far or the wrong direction, they lose time, if they set
+ * the potentiometer to a correct value, they complete the task.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskDirection_step(void);
 
 /*!
- * \brief This function handles the Power task
+ * \brief This function starts the Power task
  *
- * This function gives the user a voltage to set the potentiometer to. The user
- * adjusts the potentiometer to the desired value. If they adjust the
- * potentiometer too far or the wrong direction, they lose time, if they set the
- * potentiometer to a correct value, they complete the task.
+ * This function gives the user a voltage to set the potentiometer to.
  *
  * \param difficulty the difficulty the game is running at
- * \param *digitalValue is the pointer to the analog input of the potentiometer
  *
  * \return None
  */
-extern void taskDivertPower(int difficulty, int *digitalValue);
+extern void taskDivertPower_start(int difficulty);
+
+/*!
+ * \brief This function runs the Power task
+ *
+ * The user adjusts the potentiometer to the desired value. If they adjust the
+ * potentiometer too far or the wrong direction, they lose time, if they set
+ * the potentiometer to a correct value, they complete the task.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskDivertPower_step(void);
 
 /*!
- * \brief This function handles the Reaction task
+ * \brief This function starts the Reaction task
  *
- * This function instructs the user to press the button when an LED of a specific
- * color lights up. If the user presses the button when another LED is on or the
- * specified LED is off, they lose time, if they press the button when the
- * specified LED is on, they complete the task.
+ * This function instructs the user to press the button when an LED of a
+ * specific color lights up and starts blinking the LEDs. The LEDs are switched
+ * by a software timer, see Tick.h.
  *
  * \param difficulty the difficulty the game is running at
  *
  * \return None
  */
-extern void taskReaction(int difficulty);
+extern void taskReaction_start(int difficulty);
+
+/*!
+ * \brief This function runs the Reaction task
+ *
+ * This function judges the button presses by their timestamps against the
+ * blinking, which is set by the difficulty. If the user pressed the button
+ * when another LED was on or the specified LED was off, they lose time, if
+ * they pressed the button when the specified LED was on, they complete the
+ * task.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskReaction_step(void);
 
 /*!
- * \brief This function handles the Binary task
+ * \brief This function gets the statistics of the Reaction task
+ *
+ * The reaction time is measured from the timestamp the LED was turned on with
+ * to the timestamp of the first edge of the press, both taken in interrupts on
+ * the Timebase. It is exact to a Timebase tick, about 31 us.
+ *
+ * \param stats is filled in with the statistics of the last Reaction task
+ *
+ * \return None
+ */
+extern void taskReaction_getStats(ReactionStats *stats);
+
+/*!
+ * \brief This function starts the Binary task
  *
  * This function generates a random value between 0 to 13 and turns on the
- * external LEDs as a binary representation of the value. The user presses a
- * button on the keypad. If the value does not correspond to the converted
- * hexadecimal value, they lose time, it the value does correspond to the
- * converted hexadecimal value, they complete the task.
+ * external LEDs as a binary representation of the value.
  *
  * \param difficulty the difficulty the game is running at
  *
  * \return None
  */
-extern void taskBinary(int difficulty);
+extern void taskBinary_start(int difficulty);
 
+/*!
+ * \brief This function runs the Binary task
+ *
+ * The user presses a button on the keypad. If the value does not correspond
+ * to the converted hexadecimal value, they lose time, it the value does
+ * correspond to the converted hexadecimal value, they complete the task.
+ *
+ * \return true if the task is complete
+ */
+extern bool taskBinary_step(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,218 @@
+/*
+ * Telemetry.c
+ *
+ * Description: Helper file for the telemetry channel. Records are sent in
+ *              chunks of whole records that are contiguous in the ring. The
+ *              first byte of a chunk is written by the CPU, the uDMA writes
+ *              the others each time UCTXIFG is set. Once the whole chunk has
+ *              left the UART its transmit complete interrupt sends the next
+ *              one, so a chunk always starts on an idle UART.
+ *
+ *  Created on: Mar 9, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Telemetry.h>
+#include <HAL.h>
+#include <Power.h>
+#include <Timebase.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define TELEMETRY_PORT                                              GPIO_PORT_P1
+#define TELEMETRY_PINS                                  (GPIO_PIN2 | GPIO_PIN3)
+#define TELEMETRY_DMA_CHANNEL                                       0
+
+static uint8_t ring[TELEMETRY_RING_RECORDS][TELEMETRY_RECORD_SIZE];
+/* Records logged and sent so far, the difference is what's queued */
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+/* Records in the chunk being sent, 0 when the UART is idle */
+static volatile uint32_t sending = 0;
+static volatile bool flushing = false;
+static uint8_t nextSequence = 0;
+
+volatile uint32_t telemetryDropped = 0;
+
+void Telemetry_init(void)
+{
+    GPIO_setAsPeripheralModuleFunctionInputPin(TELEMETRY_PORT, TELEMETRY_PINS,
+    GPIO_PRIMARY_MODULE_FUNCTION);
+
+    // With oversampling SMCLK / baud is 16 * UCBRx + UCBRFx, UCBRSx is left 0
+    const uint32_t divider = CS_getSMCLK() / TELEMETRY_BAUD;
+    const eUSCI_UART_ConfigV1 config = {
+            EUSCI_A_UART_CLOCKSOURCE_SMCLK,
+            divider / 16,
+            divider % 16,
+            0,
+            EUSCI_A_UART_NO_PARITY,
+            EUSCI_A_UART_LSB_FIRST,
+            EUSCI_A_UART_ONE_STOP_BIT,
+            EUSCI_A_UART_MODE,
+            EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION,
+            EUSCI_A_UART_8_BIT_LEN };
+    UART_initModule(EUSCI_A0_BASE, &config);
+    UART_enableModule(EUSCI_A0_BASE);
+    UART_clearInterruptFlag(EUSCI_A0_BASE,
+    EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT_FLAG);
+    UART_enableInterrupt(EUSCI_A0_BASE,
+                         EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT);
+    Interrupt_enableInterrupt(INT_EUSCIA0);
+
+    // Bytes from the ring into TXBUF, one per request
+    DMA_assignChannel(DMA_CH0_EUSCIA0TX);
+    DMA_disableChannelAttribute(DMA_CH0_EUSCIA0TX,
+    UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY |
+    UDMA_ATTR_REQMASK);
+    DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+    UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_1);
+}
+
+/*!
+ * \brief This function writes a record into the ring
+ *
+ * \param record is the slot of the ring to write
+ * \param type is the TelemetryType of the record
+ * \param sequence is the sequence number of the record
+ * \param time is the Timebase time of the record
+ * \param value is the value of the record
+ *
+ * \return None
+ */
+void Telemetry_pack(uint8_t *record, TelemetryType type, uint8_t sequence,
+                    uint32_t time, int32_t value)
+{
+    record[0] = TELEMETRY_SYNC;
+    record[1] = type;
+    record[2] = sequence;
+    record[3] = time;
+    record[4] = time >> 8;
+    record[5] = time >> 16;
+    record[6] = time >> 24;
+    record[7] = value;
+    record[8] = (uint32_t) value >> 8;
+    record[9] = (uint32_t) value >> 16;
+    record[10] = (uint32_t) value >> 24;
+    uint8_t check = 0;
+    int i;
+    for (i = 0; i < TELEMETRY_RECORD_SIZE - 1; i++)
+    {
+        check ^= record[i];
+    }
+    record[TELEMETRY_RECORD_SIZE - 1] = check;
+}
+
+void Telemetry_log(TelemetryType type, int32_t value)
+{
+    // Masked so records from interrupts don't interleave, and so they are
+    // queued in the order of their times
+    bool wasDisabled = Interrupt_disableMaster();
+    const uint8_t sequence = nextSequence++;
+    if (head - tail < TELEMETRY_RING_RECORDS)
+    {
+        Telemetry_pack(ring[head & (TELEMETRY_RING_RECORDS - 1)], type,
+                       sequence, Timebase_now(), value);
+        head++;
+        // The UART is idle, its interrupt starts sending
+        if (!sending)
+        {
+            Interrupt_pendInterrupt(INT_EUSCIA0);
+        }
+    }
+    else
+    {
+        telemetryDropped++;
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+/*!
+ * \brief This function starts sending the next chunk of the ring
+ *
+ * The uDMA can't wrap around the ring, so records at its end and at its start
+ * go in separate chunks. Must be called with the UART idle.
+ *
+ * \return None
+ */
+void Telemetry_send(void)
+{
+    const uint32_t queued = head - tail;
+    if (queued == 0)
+    {
+        return;
+    }
+    const uint32_t first = tail & (TELEMETRY_RING_RECORDS - 1);
+    uint32_t records = TELEMETRY_RING_RECORDS - first;
+    if (records > queued)
+    {
+        records = queued;
+    }
+    sending = records;
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH0_EUSCIA0TX,
+                           UDMA_MODE_BASIC, &ring[first][1],
+                           (void*) HAL_getUARTTransmitAddress(),
+                           records * TELEMETRY_RECORD_SIZE - 1);
+    DMA_enableChannel(TELEMETRY_DMA_CHANNEL);
+    // The uDMA is triggered when UCTXIFG gets set, which is already the case
+    // on an idle UART, so the first byte is written here. TXBUF is empty, so
+    // this doesn't wait.
+    UART_transmitData(EUSCI_A0_BASE, ring[first][0]);
+}
+
+void Telemetry_flush(void)
+{
+    flushing = true;
+    while (head != tail)
+    {
+        Power_sleep(WAKE_TELEMETRY);
+    }
+    flushing = false;
+}
+
+void Telemetry_logBlock(TelemetryType type, const void *block,
+                        uint32_t length)
+{
+    const uint8_t *bytes = (const uint8_t*) block;
+    uint32_t at;
+    for (at = 0; at < length; at += 4)
+    {
+        // Wait for room rather than have the ring drop records
+        if (at % (2 * TELEMETRY_RING_RECORDS) == 0)
+        {
+            Telemetry_flush();
+        }
+        Telemetry_log(
+                type,
+                bytes[at] | bytes[at + 1] << 8 | bytes[at + 2] << 16
+                        | (uint32_t) bytes[at + 3] << 24);
+    }
+    Telemetry_flush();
+}
+
+/*!
+ * \brief This function handles the EUSCIA0 interrupt
+ *
+ * This function runs when the UART finished sending a chunk, or when
+ * Telemetry_log pends it while the UART is idle. It sends the next chunk.
+ *
+ * \return None
+ */
+void EUSCIA0_IRQHandler(void)
+{
+    UART_clearInterruptFlag(EUSCI_A0_BASE,
+    EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT_FLAG);
+    // A late uDMA request can let the UART run dry in the middle of a chunk
+    if (DMA_isChannelEnabled(TELEMETRY_DMA_CHANNEL))
+    {
+        return;
+    }
+    tail += sending;
+    sending = 0;
+    Telemetry_send();
+    if (!sending && flushing)
+    {
+        Power_wake(WAKE_TELEMETRY);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Telemetry.h
+ *
+ * Description: Header file for the telemetry channel. Records are sent on the
+ *              XDS110 backchannel UART (eUSCI_A0, P1.2/P1.3, 115200 8N1)
+ *              while the game runs. Logging a record only copies it into a
+ *              ring in RAM, the uDMA feeds the ring to the UART in the
+ *              background. When the ring is full new records are dropped and
+ *              counted, logging never waits for the UART.
+ *
+ *              Every record is TELEMETRY_RECORD_SIZE bytes, little-endian:
+ *                  0       TELEMETRY_SYNC
+ *                  1       TelemetryType
+ *                  2       sequence number, counts dropped records too
+ *                  3 - 6   Timebase ticks when the record was logged
+ *                  7 - 10  value, signed
+ *                  11      XOR of bytes 0 - 10
+ *
+ *              host/HostTelemetry.c decodes the records into CSV.
+ *
+ *  Created on: Mar 9, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TELEMETRY_BAUD                                              115200
+#define TELEMETRY_SYNC                                              0xA5
+#define TELEMETRY_RECORD_SIZE                                       12
+/* Must be a power of 2 */
+#define TELEMETRY_RING_RECORDS                                      64
+
+/* What a record reports, its value is in parentheses */
+typedef enum _TelemetryType
+{
+    TELEMETRY_DIFFICULTY,   // (difficulty picked, 0 - 2)
+    TELEMETRY_TASK_START,   // (Task, in the order of Tasks in main.c)
+    TELEMETRY_TASK_DONE,    // (Task)
+    TELEMETRY_PENALTY,      // (seconds taken off the game timer)
+    TELEMETRY_SENSOR_POT,   // (latest 14-bit sample of the sensor)
+    TELEMETRY_SENSOR_THERM, // (latest 14-bit sample of the sensor)
+    TELEMETRY_SENSOR_PHOTO, // (latest 14-bit sample of the sensor)
+    TELEMETRY_SALARY,       // (salary in dollars)
+    TELEMETRY_TRACE,        // (4 bytes of a recording, see Trace.h)
+    TELEMETRY_PROFILE,      // (4 bytes of a profile, see Profile.h)
+    TELEMETRY_REACTION,     // (reaction time of the Reaction task in us)
+    NUM_OF_TELEMETRY_TYPES
+} TelemetryType;
+
+/*!
+ * \brief This function initializes the telemetry channel
+ *
+ * This function sets up eUSCI_A0 as a UART on the backchannel pins and uDMA
+ * channel 0 to feed it. It must be called after DMAControl_init.
+ *
+ * \return None
+ */
+extern void Telemetry_init(void);
+
+/*!
+ * \brief This function logs a record
+ *
+ * This function can be called from interrupts. It never waits, if the ring
+ * is full the record is dropped and counted in telemetryDropped.
+ *
+ * \param type is the TelemetryType of the record
+ * \param value is the value of the record
+ *
+ * \return None
+ */
+extern void Telemetry_log(TelemetryType type, int32_t value);
+
+/*!
+ * \brief This function waits until every logged record has been sent
+ *
+ * The CPU sleeps in LPM0 while it waits.
+ *
+ * \return None
+ */
+extern void Telemetry_flush(void);
+
+/*!
+ * \brief This function sends a block of memory, 4 bytes per record
+ *
+ * Unlike Telemetry_log this function waits for room in the ring, so nothing
+ * is dropped. The CPU sleeps in LPM0 while it waits, so interrupts must be
+ * enabled. It returns once every record has been sent.
+ *
+ * \param type is the TelemetryType of the records
+ * \param block is the memory to send
+ * \param length is the number of bytes to send, a multiple of 4
+ *
+ * \return None
+ */
+extern void Telemetry_logBlock(TelemetryType type, const void *block,
+                               uint32_t length);
+
+/* Records dropped because the ring was full, readable from the debugger */
+extern volatile uint32_t telemetryDropped;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H_ */
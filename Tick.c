@@ -0,0 +1,281 @@
+/*
+ * Tick.c
+ *
+ * Description: Helper file for the millisecond tick service on TimerA3 CCR0
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Tick.h>
+#include <Probe.h>
+#include <Timebase.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define SLOT_MASK                                          (TICK_SLOTS - 1)
+/* Timers that expired and wait for their callbacks, after the slots */
+#define DUE_LIST                                            (TICK_SLOTS + 1)
+/* Shortest delay CCR0 is set to, in Timebase ticks */
+#define MIN_COMPARE_TICKS                                           2
+/* Multiplier of the de Bruijn sequence for finding the lowest set bit */
+#define DE_BRUIJN                                                   0x077CB531u
+
+/* Heads of the slot lists and the due list, indexed by list - 1 */
+static TickTimer *lists[DUE_LIST];
+/* One bit per slot that holds a timer */
+static uint32_t occupied = 0;
+/* Last tick whose slot has been visited */
+static uint64_t lastRun = 0;
+/* Tick CCR0 is set for, while compareArmed */
+static uint32_t compareTick = 0;
+static bool compareArmed = false;
+/* Set while PendSV runs, it sets CCR0 itself when it is done */
+static bool running = false;
+
+static const uint8_t deBruijnBits[32] = {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+
+/*!
+ * \brief This function adds a timer to the front of a list
+ *
+ * \param timer is the timer, which must be idle
+ * \param list is 1 + the slot, or DUE_LIST
+ *
+ * \return None
+ */
+void Tick_link(TickTimer *timer, uint8_t list)
+{
+    TickTimer **head = &lists[list - 1];
+    timer->next = *head;
+    if (*head)
+    {
+        (*head)->link = &timer->next;
+    }
+    *head = timer;
+    timer->link = head;
+    timer->list = list;
+    if (list != DUE_LIST)
+    {
+        occupied |= 1u << (list - 1);
+    }
+}
+
+/*!
+ * \brief This function takes a timer out of its list
+ *
+ * \param timer is the timer, which must be armed
+ *
+ * \return None
+ */
+void Tick_unlink(TickTimer *timer)
+{
+    *timer->link = timer->next;
+    if (timer->next)
+    {
+        timer->next->link = timer->link;
+    }
+    if (timer->list != DUE_LIST && !lists[timer->list - 1])
+    {
+        occupied &= ~(1u << (timer->list - 1));
+    }
+    timer->list = 0;
+}
+
+/*!
+ * \brief This function adds a timer to the slot of its expiry tick
+ *
+ * \return None
+ */
+void Tick_insert(TickTimer *timer)
+{
+    Tick_link(timer, (timer->expiry & SLOT_MASK) + 1);
+}
+
+/*!
+ * \brief This function sets CCR0 for the next tick whose slot holds a timer
+ *
+ * A slot may hold only timers of later turns of the wheel, then the tick
+ * finds nothing due and CCR0 is set again. This function runs from PendSV.
+ *
+ * \return None
+ */
+void Tick_program(void)
+{
+    if (!occupied)
+    {
+        Timer_A_disableCaptureCompareInterrupt(TIMER_A3_BASE,
+        TIMER_A_CAPTURECOMPARE_REGISTER_0);
+        compareArmed = false;
+        return;
+    }
+    // Rotate the slot after lastRun down to bit 0, then find the lowest bit
+    const uint32_t shift = (uint32_t) (lastRun + 1) & SLOT_MASK;
+    const uint32_t rotated =
+            shift ? (occupied >> shift) | (occupied << (TICK_SLOTS - shift)) :
+                    occupied;
+    const uint32_t lowest = rotated & (0u - rotated);
+    const uint64_t next = lastRun + 1 + deBruijnBits[lowest * DE_BRUIJN >> 27];
+
+    // First Timebase tick at or after the start of the tick
+    uint64_t target = (next * TIMEBASE_HZ + TICK_HZ - 1) / TICK_HZ;
+    const uint64_t soonest = Timebase_now64() + MIN_COMPARE_TICKS;
+    if (target < soonest)
+    {
+        target = soonest;
+    }
+    Timer_A_setCompareValue(TIMER_A3_BASE, TIMER_A_CAPTURECOMPARE_REGISTER_0,
+                            (uint16_t) target);
+    Timer_A_clearCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    Timer_A_enableCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    compareTick = (uint32_t) next;
+    compareArmed = true;
+}
+
+void Tick_init(void)
+{
+    lastRun = Tick_now();
+    Interrupt_enableInterrupt(INT_TA3_0);
+}
+
+uint64_t Tick_now(void)
+{
+    return Timebase_now64() * TICK_HZ / TIMEBASE_HZ;
+}
+
+void Tick_start(TickTimer *timer, uint32_t ms, uint32_t period,
+                Tick_Callback callback)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    if (timer->list)
+    {
+        Tick_unlink(timer);
+    }
+    timer->expiry = (uint32_t) Tick_now() + (ms ? ms : 1);
+    timer->period = period;
+    timer->callback = callback;
+    Tick_insert(timer);
+    // PendSV sets CCR0 when it is done, otherwise only an earlier tick matters
+    if (!running
+            && (!compareArmed || (int32_t) (timer->expiry - compareTick) < 0))
+    {
+        Interrupt_pendInterrupt(FAULT_PENDSV);
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+void Tick_cancel(TickTimer *timer)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    if (timer->list)
+    {
+        Tick_unlink(timer);
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+bool Tick_isArmed(const TickTimer *timer)
+{
+    return timer->list != 0;
+}
+
+uint32_t Tick_remaining(const TickTimer *timer)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    const int32_t left = (int32_t) (timer->expiry - (uint32_t) Tick_now());
+    const bool armed = timer->list != 0;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return armed && left > 0 ? left : 0;
+}
+
+/*!
+ * \brief This function handles the interrupt of TA3 CCR0
+ *
+ * This function is the tick. It leaves the timers to PendSV.
+ *
+ * \return None
+ */
+void TA3_0_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    Timer_A_clearCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    Timer_A_disableCaptureCompareInterrupt(TIMER_A3_BASE,
+    TIMER_A_CAPTURECOMPARE_REGISTER_0);
+    compareArmed = false;
+    Interrupt_pendInterrupt(FAULT_PENDSV);
+    PROBE_END(probe, PROBE_TA3_0);
+}
+
+/*!
+ * \brief This function handles PendSV
+ *
+ * This function visits the slots of the ticks since the last run, runs the
+ * callbacks of the timers that expired, restarts the periodic ones and sets
+ * CCR0 for the next tick that has a timer.
+ *
+ * \return None
+ */
+void PendSV_Handler(void)
+{
+    PROBE_BEGIN(probe);
+    const uint64_t now = Tick_now();
+    running = true;
+
+    // Slots of the ticks lastRun + 1 to now, every slot after a full turn
+    const uint64_t span = now - lastRun;
+    uint32_t visit = occupied;
+    if (span < TICK_SLOTS)
+    {
+        const uint32_t shift = (uint32_t) (lastRun + 1) & SLOT_MASK;
+        const uint32_t range = (1u << span) - 1;
+        visit &= shift ? (range << shift) | (range >> (TICK_SLOTS - shift)) :
+                        range;
+    }
+    lastRun = now;
+    while (visit)
+    {
+        const uint32_t lowest = visit & (0u - visit);
+        visit &= visit - 1;
+        TickTimer *timer = lists[deBruijnBits[lowest * DE_BRUIJN >> 27]];
+        while (timer)
+        {
+            TickTimer *next = timer->next;
+            if ((int32_t) (timer->expiry - (uint32_t) now) <= 0)
+            {
+                Tick_unlink(timer);
+                Tick_link(timer, DUE_LIST);
+            }
+            timer = next;
+        }
+    }
+
+    // A callback may start or cancel any timer, the due ones included
+    TickTimer *timer;
+    while ((timer = lists[DUE_LIST - 1]) != 0)
+    {
+        Tick_unlink(timer);
+        if (timer->period)
+        {
+            // Runs that were missed are skipped, the phase is kept
+            const uint32_t late = (uint32_t) now - timer->expiry;
+            timer->expiry += timer->period * (late / timer->period + 1);
+            Tick_insert(timer);
+        }
+        timer->callback();
+    }
+
+    running = false;
+    Tick_program();
+    PROBE_END(probe, PROBE_PENDSV);
+}
@@ -0,0 +1,120 @@
+/*
+ * Tick.h
+ *
+ * Description: Header file for the millisecond tick service. Software timers,
+ *              one-shot or periodic, are kept in a hashed timer wheel of
+ *              TICK_SLOTS slots, a timer in the slot of its expiry tick
+ *              modulo TICK_SLOTS, so starting and cancelling one are O(1).
+ *              The tick comes from CCR0 of TimerA3, the Timebase timer, and
+ *              only fires for ticks whose slot holds a timer. Its interrupt
+ *              just pends PendSV, whose handler runs the callbacks of the
+ *              timers that expired.
+ *
+ *              PendSV has the priority of the other handlers, so callbacks
+ *              run to completion like a handler does and nothing else that
+ *              uses the wheel can preempt them.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef TICK_H_
+#define TICK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TICK_HZ                                                     1000
+/* Slots of the wheel, one bit each in a 32-bit mask */
+#define TICK_SLOTS                                                  32
+
+typedef void (*Tick_Callback)(void);
+
+/* A software timer, owned by the caller and kept in the wheel while armed.
+ * A zeroed timer is idle. */
+typedef struct _TickTimer
+{
+    struct _TickTimer *next;
+    struct _TickTimer **link;   // The pointer to this timer in its list
+    uint32_t expiry;            // Tick the timer runs at
+    uint32_t period;            // Ticks between runs, 0 for a one-shot timer
+    Tick_Callback callback;
+    uint8_t list;               // 1 + the slot it is in, 0 while idle
+} TickTimer;
+
+/*!
+ * \brief This function starts the tick service
+ *
+ * The Timebase must be initialized first.
+ *
+ * \return None
+ */
+extern void Tick_init(void);
+
+/*!
+ * \brief This function gets the monotonic time
+ *
+ * This function is safe to call from interrupts and with interrupts disabled.
+ *
+ * \return the number of milliseconds since Timebase_init
+ */
+extern uint64_t Tick_now(void);
+
+/*!
+ * \brief This function starts a software timer
+ *
+ * The callback first runs ms ticks after the current one, so between ms - 1
+ * and ms milliseconds from now, then every period ticks if period isn't 0.
+ * Starting an armed timer restarts it. This function is safe to call from
+ * interrupts and callbacks, a callback may restart its own timer.
+ *
+ * \param timer is the timer, which must stay allocated while it is armed
+ * \param ms is the number of ticks to wait, at least 1
+ * \param period is the number of ticks between runs, or 0 to run once
+ * \param callback is the function to call from PendSV
+ *
+ * \return None
+ */
+extern void Tick_start(TickTimer *timer, uint32_t ms, uint32_t period,
+                       Tick_Callback callback);
+
+/*!
+ * \brief This function stops a software timer
+ *
+ * The callback won't run after this function returns. Cancelling a timer that
+ * isn't armed does nothing.
+ *
+ * \param timer is the timer to stop
+ *
+ * \return None
+ */
+extern void Tick_cancel(TickTimer *timer);
+
+/*!
+ * \brief This function checks whether a software timer is armed
+ *
+ * \param timer is the timer to check
+ *
+ * \return true if the callback is still going to run
+ */
+extern bool Tick_isArmed(const TickTimer *timer);
+
+/*!
+ * \brief This function gets the time until a software timer runs
+ *
+ * \param timer is the timer to check
+ *
+ * \return the number of milliseconds left, 0 if the timer isn't armed
+ */
+extern uint32_t Tick_remaining(const TickTimer *timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICK_H_ */
@@ -0,0 +1,93 @@
+/*
+ * Timebase.c
+ *
+ * Description: Helper file for the free-running timebase on TimerA3
+ *
+ *  Created on: Mar 2, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Timebase.h>
+#include <HAL.h>
+#include <Probe.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Upper 32 bits of the timebase, counted by TimerA3 overflows */
+static volatile uint32_t overflows = 0;
+
+void Timebase_init(void)
+{
+    CS_setReferenceOscillatorFrequency(CS_REFO_32KHZ);
+    CS_initClockSignal(CS_ACLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+
+    const Timer_A_ContinuousModeConfig continuousConfig = {
+            TIMER_A_CLOCKSOURCE_ACLK,
+            TIMER_A_CLOCKSOURCE_DIVIDER_1,
+            TIMER_A_TAIE_INTERRUPT_ENABLE,
+            TIMER_A_DO_CLEAR };
+    Timer_A_configureContinuousMode(TIMER_A3_BASE, &continuousConfig);
+    Interrupt_enableInterrupt(INT_TA3_N);
+    Timer_A_startCounter(TIMER_A3_BASE, TIMER_A_CONTINUOUS_MODE);
+}
+
+/*!
+ * \brief This function reads the TimerA3 count
+ *
+ * ACLK is asynchronous to MCLK, so the count is read until two reads agree.
+ *
+ * \return the lower 16 bits of the timebase
+ */
+uint16_t Timebase_readCount(void)
+{
+    uint16_t count;
+    do
+    {
+        count = HAL_readTimerCount(TIMER_A3_BASE);
+    }
+    while (count != HAL_readTimerCount(TIMER_A3_BASE));
+    return count;
+}
+
+uint64_t Timebase_now64(void)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    uint64_t high = overflows;
+    uint16_t low = Timebase_readCount();
+    // Overflow happened but its interrupt hasn't run yet
+    if (HAL_isTimerOverflowPending(TIMER_A3_BASE) && low < 0x8000)
+    {
+        high++;
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return (high << 16) | low;
+}
+
+uint32_t Timebase_now(void)
+{
+    return (uint32_t) Timebase_now64();
+}
+
+uint32_t Timebase_toMillis(uint32_t ticks)
+{
+    return (uint64_t) ticks * 1000 / TIMEBASE_HZ;
+}
+
+/*!
+ * \brief This function handles the interrupt of TA3 CCRN
+ *
+ * This function counts overflows of TimerA3.
+ *
+ * \return None
+ */
+void TA3_N_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    // Reading IV clears the highest pending flag
+    while (HAL_readTimerVector(TIMER_A3_BASE) == 0x0E)
+    {
+        overflows++;
+    }
+    PROBE_END(probe, PROBE_TA3_N);
+}
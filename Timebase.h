@@ -0,0 +1,68 @@
+/*
+ * Timebase.h
+ *
+ * Description: Header file for the free-running timebase. TimerA3 counts
+ *              ACLK (32.768 kHz REFO) continuously and its overflows extend
+ *              the count to 48 bits. CCR0 is the tick of the software timers,
+ *              see Tick.h.
+ *
+ *  Created on: Mar 2, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DriverLib Includes */
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define TIMEBASE_HZ                                                 32768
+#define TIMEBASE_MS(ms)                  ((uint32_t) (ms) * TIMEBASE_HZ / 1000)
+
+/*!
+ * \brief This function initializes the timebase
+ *
+ * This function selects the 32.768 kHz REFO for ACLK and starts TimerA3 in
+ * continuous mode. TimerA3_N interrupts are enabled.
+ *
+ * \return None
+ */
+extern void Timebase_init(void);
+
+/*!
+ * \brief This function gets the current time
+ *
+ * This function is safe to call from interrupts and with interrupts disabled.
+ *
+ * \return the number of TIMEBASE_HZ ticks since Timebase_init, wraps after
+ *          about 36 hours
+ */
+extern uint32_t Timebase_now(void);
+
+/*!
+ * \brief This function gets the current time without wrapping
+ *
+ * This function is safe to call from interrupts and with interrupts disabled.
+ *
+ * \return the number of TIMEBASE_HZ ticks since Timebase_init
+ */
+extern uint64_t Timebase_now64(void);
+
+/*!
+ * \brief This function converts timebase ticks into milliseconds
+ *
+ * \param ticks is a number of TIMEBASE_HZ ticks
+ *
+ * \return ticks in milliseconds, rounded down
+ */
+extern uint32_t Timebase_toMillis(uint32_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMEBASE_H_ */
@@ -7,8 +7,19 @@
  *      Author: Cooper Brotherton
  */
 #include <Timer.h>
+#include <Tick.h>
+#include <Sound.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+/* Countdown of the game, kept while it runs */
+static TickTimer gameTimer;
+/* Milliseconds that were left when the countdown stopped */
+static volatile uint32_t stoppedMs = 0;
+static Timer_Callback onDeadline;
+/* Beeps and LED1 flashes, on and off for 1/60 of the time left each */
+static TickTimer beepTimer;
+static bool beepOn = false;
+
 /*!
  *  \brief This function initializes LED 1 (P1.0)
  *
@@ -20,86 +31,96 @@ void Blink_LED_init(void)
     GPIO_setOutputLowOnPin(BLINK_PORT, BLINK_PIN);
 }
 
+void Timer_init(void)
+{
+    Blink_LED_init();
+}
+
 /*!
- * \brief This function initializes the buzzer
+ * \brief This function turns the beep and LED1 on or off
  *
- * This function sets P2.6 as a PWM output and sets up TA0.0 in PWM mode.
- * TimerA2_0 and TimerA2_N interrupts are enabled.
+ * This function is run by beepTimer. Each half of a beep lasts 1/60 of the
+ * time left, so the beeps speed up as the countdown runs out, and stop in the
+ * last 60 ms. The beep is SOUND_COUNTDOWN played at that length, unless a
+ * jingle is playing. From TIMER_HURRY_MS on it is SOUND_HURRY, which cuts
+ * the jingles off.
  *
  * \return None
  */
-void Buzzer_init(void)
+void Timer_beep(void)
 {
-    GPIO_setAsPeripheralModuleFunctionOutputPin(GPIO_PORT_P2,
-    GPIO_PIN6,
-                                                GPIO_PRIMARY_MODULE_FUNCTION);
-    // Timer_A0 PWM config for speaker, initialized to off
-    const Timer_A_PWMConfig compareConfig_PWM = {
-            TIMER_A_CLOCKSOURCE_SMCLK,
-            TIMER_A_CLOCKSOURCE_DIVIDER_1,
-            0,
-            TIMER_A_CAPTURECOMPARE_REGISTER_0,
-            TIMER_A_OUTPUTMODE_TOGGLE, 0 };
-    Timer_A_generatePWM(TIMER_A0_BASE, &compareConfig_PWM);
-    Interrupt_enableInterrupt(INT_TA2_0);
-    Interrupt_enableInterrupt(INT_TA2_N);
+    beepOn = !beepOn;
+    if (beepOn)
+    {
+        GPIO_setOutputHighOnPin(BLINK_PORT, BLINK_PIN);
+    }
+    else
+    {
+        GPIO_setOutputLowOnPin(BLINK_PORT, BLINK_PIN);
+    }
+    const uint32_t left = Timer_getRemainingMs();
+    const uint32_t half = left / 60;
+    if (half)
+    {
+        if (beepOn)
+        {
+            Sound_play(left < TIMER_HURRY_MS ? SOUND_HURRY : SOUND_COUNTDOWN,
+                       half, 0);
+        }
+        Tick_start(&beepTimer, half, 0, Timer_beep);
+    }
 }
 
-void Timer_init(void)
+void Timer_start(uint32_t ms, Timer_Callback callback)
 {
-    Blink_LED_init();
-    Buzzer_init();
-
-    Timer32_initModule(TIMER32_0_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT,
-    TIMER32_FREE_RUN_MODE);
-    Timer32_enableInterrupt(TIMER32_0_BASE);
-    Interrupt_enableInterrupt(INT_T32_INT1);
-
-    // Timer_A2 up down config for buzzer/LED toggle
-    const Timer_A_UpDownModeConfig upDownConfig = {
-            TIMER_A_CLOCKSOURCE_SMCLK,
-            TIMER_A_CLOCKSOURCE_DIVIDER_64,
-            300000,
-            TIMER_A_TAIE_INTERRUPT_ENABLE,
-            TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE,
-            TIMER_A_DO_CLEAR };
+    onDeadline = callback;
+    stoppedMs = 0;
+    Tick_start(&gameTimer, ms, 0, callback);
+    beepOn = false;
+    Tick_start(&beepTimer, ms / 60, 0, Timer_beep);
+}
 
-    Timer_A_configureUpDownMode(TIMER_A2_BASE, &upDownConfig);
+void Timer_stop(void)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    if (Tick_isArmed(&gameTimer))
+    {
+        stoppedMs = Tick_remaining(&gameTimer);
+        Tick_cancel(&gameTimer);
+    }
+    Tick_cancel(&beepTimer);
+    beepOn = false;
+    Sound_stop();
+    GPIO_setOutputLowOnPin(BLINK_PORT, BLINK_PIN);
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
 }
 
-/*!
- * \brief This function handles the interrupt of TA2 CCR0
- *
- * This function turns makes the speaker beep and turns the LED on
- *
- *\return None
- */
-void TA2_0_IRQHandler(void)
+void Timer_penalize(uint32_t ms)
 {
-    Timer_A_clearCaptureCompareInterrupt(TIMER_A2_BASE,
-    TIMER_A_CAPTURECOMPARE_REGISTER_0);
-    Timer_A_setCompareValue(TIMER_A0_BASE,
-    TIMER_A_CAPTURECOMPARE_REGISTER_0,
-                            BEEP);
-    GPIO_setOutputHighOnPin(BLINK_PORT, BLINK_PIN);
+    bool wasDisabled = Interrupt_disableMaster();
+    if (Tick_isArmed(&gameTimer))
+    {
+        const uint32_t left = Tick_remaining(&gameTimer);
+        // Tick_start runs the callback on the next tick at the earliest
+        Tick_start(&gameTimer, left > ms ? left - ms : 0, 0, onDeadline);
+    }
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
 }
 
-/*!
- * \brief This function handles the interrupt of TA2 CCRN
- *
- * This function turns off the speaker and LED and adjusts the frequency based on
- * the time remaining in Timer32.
- *
- * \return None
- */
-void TA2_N_IRQHandler(void)
+uint32_t Timer_getRemainingMs(void)
 {
-    Timer_A_clearInterruptFlag(TIMER_A2_BASE);
-    Timer_A_setCompareValue(TIMER_A0_BASE,
-    TIMER_A_CAPTURECOMPARE_REGISTER_0,
-                            0);
-    Timer_A_setCompareValue(TIMER_A2_BASE,
-    TIMER_A_CAPTURECOMPARE_REGISTER_0,
-                            Timer32_getValue(TIMER32_0_BASE) / 3840);
-    GPIO_setOutputLowOnPin(BLINK_PORT, BLINK_PIN);
+    bool wasDisabled = Interrupt_disableMaster();
+    const uint32_t ms =
+            Tick_isArmed(&gameTimer) ? Tick_remaining(&gameTimer) : stoppedMs;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+    return ms;
 }
@@ -1,7 +1,10 @@
 /*
  * Timer.h
  *
- * Description: Header file for handling the game timer
+ * Description: Header file for handling the game timer. The countdown and
+ *              the beeps are software timers on the millisecond tick, so
+ *              they run from ACLK and don't care what MCLK does or whether
+ *              the CPU is awake.
  *
  *   Edited on: Feb 12, 2021
  *      Author: Cooper Brotherton
@@ -10,19 +13,66 @@
 #ifndef TIMER_H_
 #define TIMER_H_
 
+/* Standard Includes */
+#include <stdint.h>
+
 #define BLINK_PORT                                                  GPIO_PORT_P1
 #define BLINK_PIN                                                   GPIO_PIN0
+/* Time left from which the beeps cut off the jingles */
+#define TIMER_HURRY_MS                                              10000
 
-#define BEEP                                                        1000
+typedef void (*Timer_Callback)(void);
 
 /*!
  * \brief This function initializes the game timer
  *
- * This function initializes LED1, the buzzer using TimerA0.0, and Timer32
- * TimerA2_0, TimerA2_N, and Timer32 interrupts are enabled.
+ * This function initializes LED1. The beeps need Sound_init.
  *
  * \return None
  */
 extern void Timer_init(void);
 
+/*!
+ * \brief This function starts the countdown
+ *
+ * This function also starts the beeps, which speed up as the time runs out.
+ * Tick_init must be called first.
+ *
+ * \param ms is the length of the countdown in milliseconds
+ * \param callback is the function to call from PendSV when the countdown
+ *          runs out
+ *
+ * \return None
+ */
+extern void Timer_start(uint32_t ms, Timer_Callback callback);
+
+/*!
+ * \brief This function stops the countdown
+ *
+ * The time left is kept for Timer_getRemainingMs and the callback won't run.
+ * The beeps stop and the buzzer and LED1 are turned off.
+ *
+ * \return None
+ */
+extern void Timer_stop(void);
+
+/*!
+ * \brief This function takes time off the countdown
+ *
+ * This function is safe to call from interrupts. If less time than the
+ * penalty is left, the callback runs on the next tick.
+ *
+ * \param ms is the penalty in milliseconds
+ *
+ * \return None
+ */
+extern void Timer_penalize(uint32_t ms);
+
+/*!
+ * \brief This function gets the time left on the game timer
+ *
+ * \return the time left in milliseconds, 0 once the countdown ran out
+ */
+extern uint32_t Timer_getRemainingMs(void);
+
 #endif /* TIMER_H_ */
@@ -0,0 +1,183 @@
+/*
+ * Trace.c
+ *
+ * Description: Helper file for the flight recorder
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <Trace.h>
+#include <Telemetry.h>
+#include <Timebase.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+/* Offsets in the ring wrap with this, TRACE_RING_SIZE is a power of 2 */
+#define TRACE_MASK                                  (TRACE_RING_SIZE - 1)
+#define VARINT_MORE                                                 0x80
+
+/* Not cleared at reset, so the recording survives a warm reset */
+/* Placed in SRAM by msp432p401r.cmd and msp432p401r_noinit.lds */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma NOINIT(traceRecorder)
+TraceRecorder traceRecorder;
+#elif defined(HAL_HOST)
+// host/HostCore.c keeps this section between runs, see HOST_NOINIT
+TraceRecorder traceRecorder __attribute__ ((section ("noinit")));
+#elif defined(__GNUC__)
+TraceRecorder traceRecorder __attribute__ ((section (".noinit")));
+#endif
+
+static volatile bool recording = false;
+static bool survived = false;
+
+bool Trace_init(void)
+{
+    const TraceRecorder *r = &traceRecorder;
+    // RAM is random after power-up, so the header also has to add up
+    survived = r->magic == TRACE_MAGIC && r->head < TRACE_RING_SIZE
+            && r->tail < TRACE_RING_SIZE && r->used <= TRACE_RING_SIZE
+            && ((r->tail + r->used) & TRACE_MASK) == r->head;
+    recording = false;
+    return survived;
+}
+
+/*!
+ * \brief This function clears the recording and starts recording
+ *
+ * \return None
+ */
+void Trace_start(void)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    TraceRecorder *r = &traceRecorder;
+    r->head = 0;
+    r->tail = 0;
+    r->used = 0;
+    r->events = 0;
+    r->baseTime = Timebase_now();
+    r->lastTime = r->baseTime;
+    r->magic = TRACE_MAGIC;
+    recording = true;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+void Trace_sendPrevious(void)
+{
+    if (survived)
+    {
+        Telemetry_logBlock(TELEMETRY_TRACE, &traceRecorder,
+                           sizeof(traceRecorder));
+    }
+    Trace_start();
+    Trace_record(TRACE_BOOT, survived);
+}
+
+/*!
+ * \brief This function encodes a varint
+ *
+ * \param bytes is where the varint is written, up to 5 bytes
+ * \param value is the value to encode
+ *
+ * \return the number of bytes written
+ */
+int Trace_encode(uint8_t *bytes, uint32_t value)
+{
+    int length = 0;
+    while (value >= VARINT_MORE)
+    {
+        bytes[length++] = (value & 0x7F) | VARINT_MORE;
+        value >>= 7;
+    }
+    bytes[length++] = value;
+    return length;
+}
+
+/*!
+ * \brief This function skips a varint in the ring
+ *
+ * \param at is the offset of the varint
+ * \param value gets the value of the varint
+ *
+ * \return the offset after the varint
+ */
+uint32_t Trace_decode(uint32_t at, uint32_t *value)
+{
+    uint8_t byte;
+    int shift = 0;
+    *value = 0;
+    do
+    {
+        byte = traceRecorder.ring[at];
+        at = (at + 1) & TRACE_MASK;
+        *value |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while (byte & VARINT_MORE);
+    return at;
+}
+
+/*!
+ * \brief This function overwrites the oldest event
+ *
+ * The next event then counts from the time of the one dropped.
+ *
+ * \return None
+ */
+void Trace_dropOldest(void)
+{
+    TraceRecorder *r = &traceRecorder;
+    const bool large = (r->ring[r->tail] & 0x0F) == TRACE_SMALL_VALUES;
+    uint32_t delta, value;
+    uint32_t at = Trace_decode((r->tail + 1) & TRACE_MASK, &delta);
+    if (large)
+    {
+        at = Trace_decode(at, &value);
+    }
+    r->baseTime += delta;
+    r->used -= (at - r->tail) & TRACE_MASK;
+    r->tail = at;
+}
+
+void Trace_record(TraceEvent event, uint32_t value)
+{
+    if (!recording)
+    {
+        return;
+    }
+    uint8_t bytes[TRACE_MAX_EVENT];
+    bool wasDisabled = Interrupt_disableMaster();
+    TraceRecorder *r = &traceRecorder;
+    const uint32_t now = Timebase_now();
+    int length = 1;
+    if (value < TRACE_SMALL_VALUES)
+    {
+        bytes[0] = event << 4 | value;
+        length += Trace_encode(&bytes[length], now - r->lastTime);
+    }
+    else
+    {
+        bytes[0] = event << 4 | TRACE_SMALL_VALUES;
+        length += Trace_encode(&bytes[length], now - r->lastTime);
+        length += Trace_encode(&bytes[length], value - TRACE_SMALL_VALUES);
+    }
+    while (r->used + length > TRACE_RING_SIZE)
+    {
+        Trace_dropOldest();
+    }
+    int i;
+    for (i = 0; i < length; i++)
+    {
+        r->ring[r->head] = bytes[i];
+        r->head = (r->head + 1) & TRACE_MASK;
+    }
+    r->used += length;
+    r->lastTime = now;
+    r->events++;
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Trace.h
+ *
+ * Description: Header file for the flight recorder. Game events are kept in
+ *              a ring in RAM that isn't cleared at reset, so after the game
+ *              aborts the last TRACE_RING_SIZE bytes of events survive a warm
+ *              reset. On the next boot the recording is sent on the telemetry
+ *              channel before a new one starts, see Trace_sendPrevious.
+ *
+ *              Events are encoded with the time since the previous event:
+ *                  byte 0  event << 4 | value, 15 if the value is 15 or more
+ *                  varint  Timebase ticks since the previous event
+ *                  varint  value - 15, only if byte 0 has 15
+ *              Varints hold 7 bits per byte, low bits first, and the top bit
+ *              is set on every byte but the last. Most events take 2 bytes.
+ *
+ *              host/HostTrace.c decodes a recording.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TRACE_MAGIC                                                 0x43415254
+/* Longest encoded event, the event byte and two 5-byte varints */
+#define TRACE_MAX_EVENT                                             11
+#define TRACE_RING_SIZE                                             2048
+#define TRACE_SMALL_VALUES                                          15
+
+/* What an event records, its value is in parentheses */
+typedef enum _TraceEvent
+{
+    TRACE_BOOT,             // (1 if a recording survived the reset, else 0)
+    TRACE_GAME_START,       // (difficulty)
+    TRACE_TASK_START,       // (Task, in the order of Tasks in main.c)
+    TRACE_TASK_DONE,        // (Task)
+    TRACE_PENALTY,          // (seconds taken off the game timer)
+    TRACE_KEY,              // (keypad_map character, plus 256 on a press)
+    TRACE_SWITCH,           // (2 * pin, plus 1 on a press)
+    TRACE_WINDOW,           // (1 above the ADC window, 0 below it)
+    TRACE_LCD_FLUSH,        // (characters written to the LCD)
+    TRACE_FIRED,            // (Task the game ended in)
+    TRACE_SALARY,           // (salary in dollars)
+    NUM_OF_TRACE_EVENTS
+} TraceEvent;
+
+/* The recording, laid out the same in RAM and in a dump of it */
+typedef struct _TraceRecorder
+{
+    uint32_t magic;         // TRACE_MAGIC once a recording started
+    uint32_t head;          // Offset the next event is written at
+    uint32_t tail;          // Offset of the oldest event
+    uint32_t used;          // Bytes from the oldest event to head
+    uint32_t baseTime;      // Timebase time the oldest event counts from
+    uint32_t lastTime;      // Timebase time of the newest event
+    uint32_t events;        // Events recorded, including overwritten ones
+    uint8_t ring[TRACE_RING_SIZE];
+} TraceRecorder;
+
+/* Kept across warm resets, also readable from the debugger */
+extern TraceRecorder traceRecorder;
+
+/*!
+ * \brief This function checks for a recording that survived a reset
+ *
+ * This function must run before anything is recorded. Nothing is recorded
+ * until Trace_sendPrevious is called.
+ *
+ * \return true if a recording survived
+ */
+extern bool Trace_init(void);
+
+/*!
+ * \brief This function sends the recording that survived a reset, then
+ *          starts a new one
+ *
+ * The recording is sent as TELEMETRY_TRACE records, 4 bytes of
+ * traceRecorder per record. The CPU sleeps in LPM0 while they are sent, so
+ * interrupts must be enabled.
+ *
+ * \return None
+ */
+extern void Trace_sendPrevious(void);
+
+/*!
+ * \brief This function records an event
+ *
+ * This function can be called from interrupts. The oldest events are
+ * overwritten once the ring is full.
+ *
+ * \param event is the TraceEvent
+ * \param value is the value of the event
+ *
+ * \return None
+ */
+extern void Trace_record(TraceEvent event, uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H_ */
@@ -2,6 +2,7 @@
  * delays.c
  *      Description: Helper file for delay functions using syTick timer. Must be
  *                   initialized with system clock frequency using initDelayTimer.
+ *                   Delays of 100 us or more sleep in LPM0 instead of spinning.
  *
  *      Author: ece230
  */
@@ -10,16 +11,35 @@
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
 #include "delays.h"
+#include "Power.h"
+#include "Tick.h"
+#include "HAL.h"
+#include "Clock.h"
 
 #define USEC_DIVISOR    1000000
 #define MSEC_DIVISOR    1000
 #define SYSTICK_LIMIT   0x00FFFFFF
+/* Shorter delays spin, waking from LPM0 costs more than they save */
+#define SLEEP_THRESHOLD 100
 
 /* Holds frequency of system clock, must be set in initDelayTimer */
 uint64_t sysClkFreq = 0;
 
+/*!
+ * \brief This function follows MCLK when the clock profile changes
+ *
+ * \param oldMCLK is the MCLK frequency before the change in Hz
+ * \param newMCLK is the MCLK frequency after the change in Hz
+ *
+ * \return None
+ */
+void delayClockChanged(uint32_t oldMCLK, uint32_t newMCLK) {
+    sysClkFreq = newMCLK;
+}
+
 void initDelayTimer(uint32_t clkFreq) {
     sysClkFreq = clkFreq;
+    Clock_listen(CLOCK_DELAYS, delayClockChanged);
 }
 
 int delayMicroSec(uint32_t micros) {
@@ -32,15 +52,44 @@ int delayMicroSec(uint32_t micros) {
     }
 
     // Set the period of the SysTick counter
-    SysTick->LOAD = ticks - 1;
-    // Write any value to reset timer counter
-    SysTick->VAL = 1;
-    SysTick_enableModule();
-    while(!(SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk));
+    HAL_loadSysTick(ticks);
+    if (micros < SLEEP_THRESHOLD) {
+        SysTick_enableModule();
+        while(!HAL_isSysTickExpired());
+    } else {
+        // SysTick_Handler posts the wake-up, the core sleeps until then
+        SysTick_enableInterrupt();
+        SysTick_enableModule();
+        Power_sleep(WAKE_SYSTICK);
+        SysTick_disableInterrupt();
+    }
     SysTick_disableModule();
     return SUCCESS;
 }
 
 int delayMilliSec(uint32_t millis) {
-    return delayMicroSec(1000 * millis);
+    if (millis == 0) {
+        return UNDERFLOW;
+    }
+
+    // Sleep on the tick, SysTick would overflow above 349 ms at 48 MHz. The
+    // current tick is already partly over, so one more is waited for.
+    const uint64_t end = Tick_now() + millis + 1;
+    uint64_t now;
+    while ((now = Tick_now()) < end) {
+        Power_sleepFor(0, end - now);
+    }
+    return SUCCESS;
+}
+
+/*!
+ * \brief This function handles the SysTick interrupt
+ *
+ * This function stops SysTick and wakes the sleeping delayMicroSec.
+ *
+ * \return None
+ */
+void SysTick_Handler(void) {
+    SysTick_disableModule();
+    Power_wake(WAKE_SYSTICK);
 }
@@ -2,6 +2,8 @@
  * delays.h
  *      Description: Header file for delay functions using syTick timer. Must be
  *                   initialized with system clock frequency using initDelayTimer.
+ *                   Delays of 100 us or more sleep in LPM0 instead of spinning,
+ *                   millisecond delays sleep on the timebase.
  *
  *      Author: ece230
  */
@@ -30,6 +32,7 @@ extern "C"
  * \brief This function initializes sysTick based delay module
  *
  * This function initializes sysTick based delay module to set clock frequency.
+ * The frequency follows MCLK when the clock profile changes, see Clock.h.
  *
  * \param clkFreq is the frequency of the system clock in Hz
  *
@@ -40,7 +43,8 @@ extern void initDelayTimer(uint32_t clkFreq);
 /*
  * \brief This function delays for specified time
  *
- * This function delays for specified microseconds using sysTick.
+ * This function delays for specified microseconds using sysTick. From 100 us
+ * up, the core sleeps in LPM0 until the SysTick interrupt.
  *
  * \param micros is the number of microseconds to delay
  *
@@ -52,12 +56,12 @@ extern int delayMicroSec(uint32_t micros);
 /*
  * \brief This function delays for specified time
  *
- * This function delays for specified milliseconds using sysTick.
+ * This function delays for specified milliseconds, sleeping in LPM0 on the
+ * millisecond tick. It does not depend on the system clock frequency.
  *
- * \param millis is the number of milliseconds to delay
+ * \param millis is the number of milliseconds to delay, at least 1
  *
- * \return 0 on success, 1 if millisecond count is too large,
- *              2 if millisecond count is too small
+ * \return 0 on success, 2 if millisecond count is too small
  */
 extern int delayMilliSec(uint32_t millis);
 
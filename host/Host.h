@@ -0,0 +1,163 @@
+/*
+ * Host.h
+ *
+ * Description: Header file for controlling the simulated board when the
+ *              firmware runs on Linux. Time is virtual: it only moves when
+ *              the firmware calls DriverLib or the HAL, or sleeps until the
+ *              next peripheral event, so runs are reproducible and much
+ *              faster than real time. The board is wired like the real one,
+ *              see main.c.
+ *
+ *              Environment variables read at startup:
+ *                  HOST_SCRIPT       file of timed inputs, see Host_loadScript
+ *                  HOST_SEED         value time() starts from, default 0
+ *                  HOST_TIME_LIMIT   virtual seconds before giving up,
+ *                                    default 600
+ *                  HOST_TRACE        1 to print the LCD whenever it changes
+ *                  HOST_PLAYER       "<reaction ms>,<mistake %>" to have a
+ *                                    simulated player play the game, see
+ *                                    HostPlayer.c
+ *                  HOST_DIFFICULTY   difficulty the player picks, 0 - 2
+ *                  HOST_UART         file the bytes sent on the backchannel
+ *                                    UART are written to, see Telemetry.h
+ *                  HOST_NOINIT       file the RAM that isn't cleared at reset
+ *                                    is loaded from and saved to, so a run
+ *                                    starts like after a warm reset of the
+ *                                    previous one, see Trace.h
+ *                  HOST_PROFILE      file the profile is saved to when the
+ *                                    run ends, like a dump from the
+ *                                    debugger, see Profile.h
+ *                  HOST_PROBES       1 to print probeStats when the run
+ *                                    ends, see Probe.h
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HOST_NS_PER_MS                                              1000000ULL
+#define HOST_NS_PER_S                                               1000000000ULL
+
+/* Exit statuses of the simulation */
+#define HOST_EXIT_DONE                                              0
+#define HOST_EXIT_ABORT                                             1
+#define HOST_EXIT_USAGE                                             2
+#define HOST_EXIT_STALLED                                           3
+#define HOST_EXIT_TIME_LIMIT                                        4
+#define HOST_EXIT_FAULT                                             5
+
+typedef void (*Host_Callback)(void *arg);
+
+/*!
+ * \brief This function gets the virtual time
+ *
+ * \return the nanoseconds since reset
+ */
+extern uint64_t Host_now(void);
+
+/*!
+ * \brief This function runs a callback at a virtual time
+ *
+ * The callback runs between firmware instructions like a peripheral event,
+ * so it may change inputs but must not call DriverLib.
+ *
+ * \param time is the virtual time in nanoseconds, the past means now
+ * \param callback is the function to run
+ * \param arg is passed to the callback
+ *
+ * \return None
+ */
+extern void Host_at(uint64_t time, Host_Callback callback, void *arg);
+
+/*!
+ * \brief This function presses or releases a keypad key
+ *
+ * \param key is the character on the key, see keypad_map
+ * \param pressed is true to press the key, false to release it
+ *
+ * \return true if the key exists
+ */
+extern bool Host_setKey(char key, bool pressed);
+
+/*!
+ * \brief This function presses or releases a switch on P1
+ *
+ * \param pin is the pin of the switch: 1, 4 or 5
+ * \param pressed is true to press the switch, false to release it
+ *
+ * \return None
+ */
+extern void Host_setSwitch(int pin, bool pressed);
+
+/*!
+ * \brief This function sets the voltage on an analog input
+ *
+ * \param input is the ADC input, ADC_INPUT_A0 - A23
+ * \param value is the voltage as a 14-bit count, 0x3FFF is AVCC
+ *
+ * \return None
+ */
+extern void Host_setAnalog(int input, uint16_t value);
+
+/*!
+ * \brief This function copies the characters the LCD shows
+ *
+ * \param lines gets the two NUL-terminated lines
+ *
+ * \return None
+ */
+extern void Host_readLCD(char lines[2][17]);
+
+/*!
+ * \brief This function gets the level of an output pin
+ *
+ * \param port is the GPIO_PORT_Px of the pin
+ * \param pin is the GPIO_PINx of the pin
+ *
+ * \return true if the pin is driven high
+ */
+extern bool Host_readPin(int port, int pin);
+
+/*!
+ * \brief This function reads the file of timed inputs
+ *
+ * Each line is "<ms> <command> <args>", where ms is the time since reset, or
+ * since the previous line if it starts with +. Commands are:
+ *      key <char> [hold ms]            press and release a keypad key
+ *      switch <pin> [hold ms]          press and release a switch
+ *      analog <A3|A4|A5> <value>       set an analog input, 14-bit count
+ * Everything after # is a comment.
+ *
+ * \param path is the file to read
+ *
+ * \return true if the whole file was understood
+ */
+extern bool Host_loadScript(const char *path);
+
+/*!
+ * \brief This function ends the simulation
+ *
+ * The LCD contents and the reason are printed before exiting.
+ *
+ * \param reason is a short description of why the run ended
+ * \param status is the exit status, see HOST_EXIT_*
+ *
+ * \return None
+ */
+extern void Host_halt(const char *reason, int status) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_H_ */
@@ -0,0 +1,385 @@
+/*
+ * HostADC.c
+ *
+ * Description: Helper file for the simulated ADC14. A conversion finishes
+ *              the moment its trigger arrives, from the voltage set with
+ *              Host_setAnalog. Each trigger converts one memory of the
+ *              sequence. The uDMA is requested at the end of the sequence.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define NUM_OF_MEMS                                                 32
+#define NUM_OF_WINDOWS                                              2
+#define WINDOW_NONE                                                 -1
+
+typedef struct _HostADC
+{
+    bool on;
+    bool enc;
+    bool sequence;
+    bool repeat;
+    uint32_t bits;
+    uint32_t trigger;
+    int start;
+    int end;
+    int current;
+    uint8_t input[NUM_OF_MEMS];
+    int8_t window[NUM_OF_MEMS];
+    uint32_t mem[NUM_OF_MEMS];      // 32-bit like ADC14MEMx, for the uDMA
+    uint16_t low[NUM_OF_WINDOWS];
+    uint16_t high[NUM_OF_WINDOWS];
+    uint64_t ifg;
+    uint64_t ie;
+    uint16_t analog[ADC_NUM_INPUTS];
+} HostADC;
+
+static HostADC adc;
+
+/*!
+ * \brief This function gets the number of a memory from its ADC_MEMx mask
+ *
+ * \return the number of the lowest memory in the mask
+ */
+int HostADC_memIndex(uint32_t memorySelect)
+{
+    return memorySelect ? __builtin_ctz(memorySelect) : 0;
+}
+
+/*!
+ * \brief This function charges the time of an ADC14 DriverLib call
+ *
+ * \return None
+ */
+void HostADC_call(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+}
+
+bool HostADC_level(void)
+{
+    return (adc.ifg & adc.ie) != 0;
+}
+
+/*!
+ * \brief This function converts the current memory of the sequence
+ *
+ * \return None
+ */
+void HostADC_convert(void)
+{
+    const int n = adc.current;
+    const uint16_t result = adc.analog[adc.input[n]] >> (14 - adc.bits);
+    adc.mem[n] = result;
+    adc.ifg |= 1ULL << n;
+    if (adc.window[n] != WINDOW_NONE)
+    {
+        const int w = adc.window[n];
+        adc.ifg |= result < adc.low[w] ? ADC_LO_INT :
+                result > adc.high[w] ? ADC_HI_INT : ADC_IN_INT;
+    }
+    if (!adc.sequence || n == adc.end)
+    {
+        adc.current = adc.start;
+        HostDMA_request(DMA_CH7_ADC14);
+    }
+    else
+    {
+        adc.current++;
+    }
+    HostCore_update(INT_ADC14);
+}
+
+void HostADC_init(void)
+{
+    int n;
+    for (n = 0; n < NUM_OF_MEMS; n++)
+    {
+        adc.window[n] = WINDOW_NONE;
+    }
+    adc.bits = 14;
+    // Pot in the middle, room temperature, room light
+    adc.analog[ADC_INPUT_A3] = 8192;
+    adc.analog[ADC_INPUT_A4] = 6000;
+    adc.analog[ADC_INPUT_A5] = 9000;
+    HostCore_setLevel(INT_ADC14, HostADC_level);
+}
+
+void HostADC_trigger(uint32_t source)
+{
+    if (adc.on && adc.enc && adc.trigger == source)
+    {
+        HostADC_convert();
+    }
+}
+
+bool HostADC_isTrigger(uint32_t source)
+{
+    return adc.trigger == source;
+}
+
+void HostADC_resultRead(const volatile void *address)
+{
+    const int n = (const volatile uint32_t*) address - adc.mem;
+    if (n >= 0 && n < NUM_OF_MEMS)
+    {
+        adc.ifg &= ~(1ULL << n);
+    }
+}
+
+void Host_setAnalog(int input, uint16_t value)
+{
+    adc.analog[input] = value & 0x3FFF;
+}
+
+void HAL_stopADCSequence(void)
+{
+    HostCore_call(HOST_ACCESS_CYCLES * 2);
+    adc.enc = false;
+    adc.sequence = false;
+    adc.repeat = false;
+    adc.current = adc.start;
+}
+
+void HAL_setADCWindow(uint_fast8_t window, uint16_t low, uint16_t high)
+{
+    HostCore_call(HOST_ACCESS_CYCLES * 2);
+    const int w = window == ADC_COMP_WINDOW0 ? 0 : 1;
+    adc.low[w] = low;
+    adc.high[w] = high;
+}
+
+volatile void* HAL_getADCResultAddress(int mem)
+{
+    return &adc.mem[mem];
+}
+
+bool ADC14_enableModule(void)
+{
+    HostADC_call();
+    adc.on = true;
+    return true;
+}
+
+bool ADC14_disableModule(void)
+{
+    HostADC_call();
+    adc.on = false;
+    adc.enc = false;
+    return true;
+}
+
+bool ADC14_initModule(uint32_t clockSource, uint32_t clockPredivider,
+                      uint32_t clockDivider, uint32_t internalChannelMask)
+{
+    HostADC_call();
+    return !adc.enc;
+}
+
+bool ADC14_enableSampleTimer(uint32_t multiSampleConvert)
+{
+    HostADC_call();
+    return !adc.enc;
+}
+
+bool ADC14_disableSampleTimer(void)
+{
+    HostADC_call();
+    return !adc.enc;
+}
+
+void ADC14_setResolution(uint32_t resolution)
+{
+    HostADC_call();
+    adc.bits = 8 + (resolution >> 4) * 2;
+}
+
+bool ADC14_setPowerMode(uint32_t powerMode)
+{
+    HostADC_call();
+    return !adc.enc;
+}
+
+bool ADC14_configureSingleSampleMode(uint32_t memoryDestination,
+                                     bool repeatMode)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    adc.sequence = false;
+    adc.repeat = repeatMode;
+    adc.start = adc.end = adc.current = HostADC_memIndex(memoryDestination);
+    return true;
+}
+
+bool ADC14_configureMultiSequenceMode(uint32_t memoryStart,
+                                      uint32_t memoryEnd, bool repeatMode)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    adc.sequence = true;
+    adc.repeat = repeatMode;
+    adc.start = adc.current = HostADC_memIndex(memoryStart);
+    adc.end = HostADC_memIndex(memoryEnd);
+    return true;
+}
+
+bool ADC14_configureConversionMemory(uint32_t memorySelect,
+                                     uint32_t refSelect,
+                                     uint32_t channelSelect,
+                                     bool differntialMode)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    adc.input[HostADC_memIndex(memorySelect)] = channelSelect;
+    return true;
+}
+
+bool ADC14_setSampleHoldTrigger(uint32_t source, bool invertSignal)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    HostTimerA_watchChanging();
+    adc.trigger = source;
+    HostTimerA_watchChanged();
+    return true;
+}
+
+bool ADC14_enableConversion(void)
+{
+    HostADC_call();
+    if (!adc.on)
+    {
+        return false;
+    }
+    adc.enc = true;
+    adc.current = adc.start;
+    return true;
+}
+
+void ADC14_disableConversion(void)
+{
+    HostADC_call();
+    adc.enc = false;
+}
+
+bool ADC14_toggleConversionTrigger(void)
+{
+    HostADC_call();
+    if (!adc.on || !adc.enc || adc.trigger != ADC_TRIGGER_ADSC)
+    {
+        return false;
+    }
+    HostADC_convert();
+    return true;
+}
+
+bool ADC14_isBusy(void)
+{
+    HostADC_call();
+    // Conversions finish as soon as they start
+    return false;
+}
+
+uint_fast16_t ADC14_getResult(uint32_t memorySelect)
+{
+    HostADC_call();
+    const int n = HostADC_memIndex(memorySelect);
+    adc.ifg &= ~(1ULL << n);
+    return adc.mem[n];
+}
+
+bool ADC14_setComparatorWindowValue(uint32_t window, int16_t low,
+                                    int16_t high)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    const int w = window == ADC_COMP_WINDOW0 ? 0 : 1;
+    adc.low[w] = low;
+    adc.high[w] = high;
+    return true;
+}
+
+bool ADC14_enableComparatorWindow(uint32_t memorySelect,
+                                  uint32_t windowSelect)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    int n;
+    for (n = 0; n < NUM_OF_MEMS; n++)
+    {
+        if (memorySelect & (1UL << n))
+        {
+            adc.window[n] = windowSelect == ADC_COMP_WINDOW0 ? 0 : 1;
+        }
+    }
+    return true;
+}
+
+bool ADC14_disableComparatorWindow(uint32_t memorySelect)
+{
+    HostADC_call();
+    if (adc.enc)
+    {
+        return false;
+    }
+    int n;
+    for (n = 0; n < NUM_OF_MEMS; n++)
+    {
+        if (memorySelect & (1UL << n))
+        {
+            adc.window[n] = WINDOW_NONE;
+        }
+    }
+    return true;
+}
+
+void ADC14_enableInterrupt(uint_fast64_t mask)
+{
+    HostADC_call();
+    adc.ie |= mask;
+    HostCore_update(INT_ADC14);
+}
+
+void ADC14_disableInterrupt(uint_fast64_t mask)
+{
+    HostADC_call();
+    adc.ie &= ~mask;
+}
+
+uint_fast64_t ADC14_getInterruptStatus(void)
+{
+    HostADC_call();
+    return adc.ifg;
+}
+
+uint_fast64_t ADC14_getEnabledInterruptStatus(void)
+{
+    HostADC_call();
+    return adc.ifg & adc.ie;
+}
+
+void ADC14_clearInterruptFlag(uint_fast64_t mask)
+{
+    HostADC_call();
+    adc.ifg &= ~mask;
+}
@@ -0,0 +1,232 @@
+/*
+ * HostClock.c
+ *
+ * Description: Helper file for the simulated clock system. It starts like the
+ *              MSP432 after reset: MCLK, HSMCLK and SMCLK run from the 3 MHz
+ *              DCO and ACLK from a 32768 Hz crystal. Timers that count a
+ *              clock are told when its frequency changes. The core voltage
+ *              and flash wait states are kept too, and the run ends with a
+ *              fault when a clock is faster than they allow, where the real
+ *              board would misbehave. In LPM3 only ACLK keeps running.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define LFXT_HZ                                                     32768
+#define VLO_HZ                                                      9400
+#define MODOSC_HZ                                                   24000000
+#define HFXT_HZ                                                     48000000
+/* Datasheet limits, VCORE0 and VCORE1 */
+#define MCLK_MAX_VCORE0_HZ                                          24000000
+#define MCLK_MAX_VCORE1_HZ                                          48000000
+#define SMCLK_MAX_VCORE0_HZ                                         12000000
+#define SMCLK_MAX_VCORE1_HZ                                         24000000
+/* Highest MCLK per flash wait state */
+#define FLASH_HZ_PER_WAIT_STATE                                     24000000
+#define NUM_OF_FLASH_BANKS                                          2
+
+typedef struct _HostClockSignal
+{
+    uint32_t source;
+    uint32_t divider;
+} HostClockSignal;
+
+static uint32_t dcoHz = 3000000;
+static uint32_t refoHz = 32768;
+static HostClockSignal aclk = { CS_LFXTCLK_SELECT, CS_CLOCK_DIVIDER_1 };
+static HostClockSignal mclk = { CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1 };
+static HostClockSignal hsmclk = { CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1 };
+static HostClockSignal smclk = { CS_DCOCLK_SELECT, CS_CLOCK_DIVIDER_1 };
+static uint8_t vcore = PCM_VCORE0;
+static uint32_t waitStates[NUM_OF_FLASH_BANKS];
+/* Set in LPM3, where MCLK, HSMCLK and SMCLK are off */
+static bool stopped = false;
+
+/* DCO frequencies of CS_DCO_FREQUENCY_1_5 - CS_DCO_FREQUENCY_48 */
+static const uint32_t dcoFrequencies[] = { 1500000, 3000000, 6000000,
+                                           12000000, 24000000, 48000000 };
+
+/*!
+ * \brief This function gets the frequency of a clock signal
+ *
+ * \param signal is the source and divider of the clock signal
+ *
+ * \return the frequency in Hz
+ */
+uint32_t HostClock_getFrequency(const HostClockSignal *signal)
+{
+    uint32_t hz;
+    switch (signal->source)
+    {
+    case CS_LFXTCLK_SELECT:
+        hz = LFXT_HZ;
+        break;
+    case CS_VLOCLK_SELECT:
+        hz = VLO_HZ;
+        break;
+    case CS_REFOCLK_SELECT:
+        hz = refoHz;
+        break;
+    case CS_MODOSC_SELECT:
+        hz = MODOSC_HZ;
+        break;
+    case CS_HFXTCLK_SELECT:
+        hz = HFXT_HZ;
+        break;
+    default:
+        hz = dcoHz;
+    }
+    return hz >> (signal->divider >> 28);
+}
+
+/*!
+ * \brief This function ends the run if a clock is too fast for the core
+ *          voltage or the flash wait states
+ *
+ * \return None
+ */
+void HostClock_check(void)
+{
+    const uint32_t mclkHz = HostClock_getMCLK();
+    const uint32_t smclkHz = HostClock_getSMCLK();
+    if (mclkHz > (vcore == PCM_VCORE1 ? MCLK_MAX_VCORE1_HZ : MCLK_MAX_VCORE0_HZ)
+            || smclkHz > (vcore == PCM_VCORE1 ?
+                    SMCLK_MAX_VCORE1_HZ : SMCLK_MAX_VCORE0_HZ))
+    {
+        Host_halt("clock too fast for the core voltage", HOST_EXIT_FAULT);
+    }
+    int bank;
+    for (bank = 0; bank < NUM_OF_FLASH_BANKS; bank++)
+    {
+        if (mclkHz > FLASH_HZ_PER_WAIT_STATE * (waitStates[bank] + 1))
+        {
+            Host_halt("MCLK too fast for the flash wait states",
+                      HOST_EXIT_FAULT);
+        }
+    }
+}
+
+/*!
+ * \brief This function tells the timers a clock frequency changed
+ *
+ * \return None
+ */
+void HostClock_changed(void)
+{
+    HostClock_check();
+    HostTimerA_clockChanged();
+    HostTimer32_clockChanged();
+    HostSysTick_clockChanged();
+}
+
+uint32_t HostClock_getMCLK(void)
+{
+    return stopped ? 0 : HostClock_getFrequency(&mclk);
+}
+
+uint32_t HostClock_getSMCLK(void)
+{
+    return stopped ? 0 : HostClock_getFrequency(&smclk);
+}
+
+uint32_t HostClock_getACLK(void)
+{
+    return HostClock_getFrequency(&aclk);
+}
+
+/*!
+ * \brief This function stops or restarts every clock but ACLK, for LPM3
+ *
+ * \param stop is true on entering LPM3, false on waking up
+ *
+ * \return None
+ */
+void HostClock_stop(bool stop)
+{
+    stopped = stop;
+    HostClock_changed();
+}
+
+void CS_setReferenceOscillatorFrequency(uint8_t referenceFrequency)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    refoHz = referenceFrequency == CS_REFO_128KHZ ? 128000 : 32768;
+    HostClock_changed();
+}
+
+void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
+                        uint32_t clockSourceDivider)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    const HostClockSignal signal = { clockSource, clockSourceDivider };
+    switch (selectedClockSignal)
+    {
+    case CS_ACLK:
+        aclk = signal;
+        break;
+    case CS_MCLK:
+        mclk = signal;
+        break;
+    case CS_HSMCLK:
+        hsmclk = signal;
+        break;
+    case CS_SMCLK:
+        smclk = signal;
+        break;
+    }
+    HostClock_changed();
+}
+
+void CS_setDCOCenteredFrequency(uint32_t dcoFreq)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dcoHz = dcoFrequencies[dcoFreq >> 16];
+    HostClock_changed();
+}
+
+uint32_t CS_getMCLK(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return HostClock_getMCLK();
+}
+
+uint32_t CS_getSMCLK(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return HostClock_getSMCLK();
+}
+
+uint32_t CS_getHSMCLK(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return HostClock_getFrequency(&hsmclk);
+}
+
+uint32_t CS_getACLK(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return HostClock_getACLK();
+}
+
+bool PCM_setCoreVoltageLevel(uint_fast8_t voltageLevel)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    vcore = voltageLevel;
+    HostClock_check();
+    return true;
+}
+
+uint8_t PCM_getCoreVoltageLevel(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return vcore == PCM_VCORE1 ? PCM_AM_LDO_VCORE1 : PCM_AM_LDO_VCORE0;
+}
+
+void FlashCtl_setWaitState(uint32_t bank, uint32_t waitState)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    waitStates[bank] = waitState;
+    HostClock_check();
+}
@@ -0,0 +1,787 @@
+/*
+ * HostCore.c
+ *
+ * Description: Helper file for the simulated Cortex-M4 core: the virtual
+ *              clock, the event loop, the NVIC and master interrupt mask, the
+ *              DWT cycle counter, and the PCM, WDT_A, PMAP and FPU calls. A
+ *              pending interrupt preempts a running handler only if its
+ *              priority is higher. Among pending interrupts of the same
+ *              priority the lowest interrupt number is taken first.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+/* For dladdr */
+#define _GNU_SOURCE
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <Power.h>
+#include <Probe.h>
+#include <Profile.h>
+
+#define DEFAULT_TIME_LIMIT_S                                        600
+/* Priority of the code outside of handlers, lower than any interrupt */
+#define THREAD_PRIORITY                                             0x100
+/* Host stack frames searched for the interrupted firmware code */
+#define MAX_FRAMES                                                  64
+
+uint64_t hostNow = 0;
+/* Nanoseconds times MCLK not yet added to hostNow */
+static uint64_t cycleRemainder = 0;
+/* DWT CYCCNT, counts MCLK cycles awake and asleep once started */
+static uint32_t cycleCount = 0;
+static bool cycleCounting = false;
+
+static uint64_t eventTimes[NUM_OF_HOST_PERIPHERALS];
+static uint64_t nextEvent = HOST_NEVER;
+static uint64_t timeLimit = DEFAULT_TIME_LIMIT_S * HOST_NS_PER_S;
+static time_t timeSeed = 0;
+static bool traceLCD = false;
+
+/* The firmware's noinit section, kept between runs in HOST_NOINIT */
+extern uint8_t __start_noinit[] __attribute__ ((weak));
+extern uint8_t __stop_noinit[] __attribute__ ((weak));
+static const char *noinitPath = NULL;
+/* Where the profile is saved when the run ends, see HOST_PROFILE */
+static const char *profilePath = NULL;
+/* Whether the probes are printed when the run ends, see HOST_PROBES */
+static bool printProbes = false;
+/* Sleep counters main keeps once a game is completed */
+extern PowerStats gamePowerStats __attribute__ ((weak));
+
+/* NVIC state, one bit per exception number */
+static uint64_t pendingMask = 0;
+/* The system exceptions can't be disabled in the NVIC */
+static uint64_t enabledMask = (1ULL << FAULT_PENDSV) | (1ULL << FAULT_SYSTICK);
+static HostCore_Level levels[NUM_INTERRUPTS];
+static uint8_t priorities[NUM_INTERRUPTS];
+static bool masked = false;
+static int activePriority = THREAD_PRIORITY;
+static int activeInterrupt = 0;
+
+void HostCore_defaultHandler(void);
+
+#define WEAK_HANDLER(name) \
+    void name(void) __attribute__ ((weak, alias("HostCore_defaultHandler")))
+
+WEAK_HANDLER(PendSV_Handler);
+WEAK_HANDLER(SysTick_Handler);
+WEAK_HANDLER(PSS_IRQHandler);
+WEAK_HANDLER(CS_IRQHandler);
+WEAK_HANDLER(PCM_IRQHandler);
+WEAK_HANDLER(WDT_A_IRQHandler);
+WEAK_HANDLER(FPU_IRQHandler);
+WEAK_HANDLER(FLCTL_IRQHandler);
+WEAK_HANDLER(COMP_E0_IRQHandler);
+WEAK_HANDLER(COMP_E1_IRQHandler);
+WEAK_HANDLER(TA0_0_IRQHandler);
+WEAK_HANDLER(TA0_N_IRQHandler);
+WEAK_HANDLER(TA1_0_IRQHandler);
+WEAK_HANDLER(TA1_N_IRQHandler);
+WEAK_HANDLER(TA2_0_IRQHandler);
+WEAK_HANDLER(TA2_N_IRQHandler);
+WEAK_HANDLER(TA3_0_IRQHandler);
+WEAK_HANDLER(TA3_N_IRQHandler);
+WEAK_HANDLER(EUSCIA0_IRQHandler);
+WEAK_HANDLER(EUSCIA1_IRQHandler);
+WEAK_HANDLER(EUSCIA2_IRQHandler);
+WEAK_HANDLER(EUSCIA3_IRQHandler);
+WEAK_HANDLER(EUSCIB0_IRQHandler);
+WEAK_HANDLER(EUSCIB1_IRQHandler);
+WEAK_HANDLER(EUSCIB2_IRQHandler);
+WEAK_HANDLER(EUSCIB3_IRQHandler);
+WEAK_HANDLER(ADC14_IRQHandler);
+WEAK_HANDLER(T32_INT1_IRQHandler);
+WEAK_HANDLER(T32_INT2_IRQHandler);
+WEAK_HANDLER(T32_INTC_IRQHandler);
+WEAK_HANDLER(AES256_IRQHandler);
+WEAK_HANDLER(RTC_C_IRQHandler);
+WEAK_HANDLER(DMA_ERR_IRQHandler);
+WEAK_HANDLER(DMA_INT3_IRQHandler);
+WEAK_HANDLER(DMA_INT2_IRQHandler);
+WEAK_HANDLER(DMA_INT1_IRQHandler);
+WEAK_HANDLER(DMA_INT0_IRQHandler);
+WEAK_HANDLER(PORT1_IRQHandler);
+WEAK_HANDLER(PORT2_IRQHandler);
+WEAK_HANDLER(PORT3_IRQHandler);
+WEAK_HANDLER(PORT4_IRQHandler);
+WEAK_HANDLER(PORT5_IRQHandler);
+WEAK_HANDLER(PORT6_IRQHandler);
+
+/* Vector table from PendSV on, indexed by exception number */
+static void (*const vectors[NUM_INTERRUPTS])(void) = {
+        [FAULT_PENDSV] = PendSV_Handler, [FAULT_SYSTICK] = SysTick_Handler,
+        [INT_PSS] = PSS_IRQHandler, [INT_CS] = CS_IRQHandler,
+        [INT_PCM] = PCM_IRQHandler, [INT_WDT_A] = WDT_A_IRQHandler,
+        [INT_FPU] = FPU_IRQHandler, [INT_FLCTL] = FLCTL_IRQHandler,
+        [INT_COMP_E0] = COMP_E0_IRQHandler, [INT_COMP_E1] = COMP_E1_IRQHandler,
+        [INT_TA0_0] = TA0_0_IRQHandler, [INT_TA0_N] = TA0_N_IRQHandler,
+        [INT_TA1_0] = TA1_0_IRQHandler, [INT_TA1_N] = TA1_N_IRQHandler,
+        [INT_TA2_0] = TA2_0_IRQHandler, [INT_TA2_N] = TA2_N_IRQHandler,
+        [INT_TA3_0] = TA3_0_IRQHandler, [INT_TA3_N] = TA3_N_IRQHandler,
+        [INT_EUSCIA0] = EUSCIA0_IRQHandler, [INT_EUSCIA1] = EUSCIA1_IRQHandler,
+        [INT_EUSCIA2] = EUSCIA2_IRQHandler, [INT_EUSCIA3] = EUSCIA3_IRQHandler,
+        [INT_EUSCIB0] = EUSCIB0_IRQHandler, [INT_EUSCIB1] = EUSCIB1_IRQHandler,
+        [INT_EUSCIB2] = EUSCIB2_IRQHandler, [INT_EUSCIB3] = EUSCIB3_IRQHandler,
+        [INT_ADC14] = ADC14_IRQHandler,
+        [INT_T32_INT1] = T32_INT1_IRQHandler,
+        [INT_T32_INT2] = T32_INT2_IRQHandler,
+        [INT_T32_INTC] = T32_INTC_IRQHandler,
+        [INT_AES256] = AES256_IRQHandler, [INT_RTC_C] = RTC_C_IRQHandler,
+        [INT_DMA_ERR] = DMA_ERR_IRQHandler,
+        [INT_DMA_INT3] = DMA_INT3_IRQHandler,
+        [INT_DMA_INT2] = DMA_INT2_IRQHandler,
+        [INT_DMA_INT1] = DMA_INT1_IRQHandler,
+        [INT_DMA_INT0] = DMA_INT0_IRQHandler,
+        [INT_PORT1] = PORT1_IRQHandler, [INT_PORT2] = PORT2_IRQHandler,
+        [INT_PORT3] = PORT3_IRQHandler, [INT_PORT4] = PORT4_IRQHandler,
+        [INT_PORT5] = PORT5_IRQHandler, [INT_PORT6] = PORT6_IRQHandler };
+
+/*!
+ * \brief This function is the handler of interrupts the firmware doesn't
+ *          handle
+ *
+ * On the MSP432 the default handler spins forever, here the run ends.
+ *
+ * \return None
+ */
+void HostCore_defaultHandler(void)
+{
+    char reason[40];
+    snprintf(reason, sizeof(reason), "unhandled interrupt %d",
+             activeInterrupt);
+    Host_halt(reason, HOST_EXIT_FAULT);
+}
+
+uint64_t HostCore_ticksToTime(uint64_t ticks, uint32_t hz)
+{
+    if (hz == 0)
+    {
+        return HOST_NEVER;
+    }
+    // Rounded up, so the tick has happened by the returned time
+    return ((unsigned __int128) ticks * HOST_NS_PER_S + hz - 1) / hz;
+}
+
+uint64_t HostCore_timeToTicks(uint64_t time, uint32_t hz)
+{
+    return (unsigned __int128) time * hz / HOST_NS_PER_S;
+}
+
+void HostCore_schedule(HostPeripheral peripheral, uint64_t time)
+{
+    eventTimes[peripheral] = time;
+    nextEvent = HOST_NEVER;
+    int i;
+    for (i = 0; i < NUM_OF_HOST_PERIPHERALS; i++)
+    {
+        if (eventTimes[i] < nextEvent)
+        {
+            nextEvent = eventTimes[i];
+        }
+    }
+}
+
+/*!
+ * \brief This function runs every peripheral event up to the virtual time
+ *
+ * Events run in time order. An event can schedule another one, which also
+ * runs if it is due.
+ *
+ * \return None
+ */
+void HostCore_runEvents(void)
+{
+    while (nextEvent <= hostNow)
+    {
+        int first = 0;
+        int i;
+        for (i = 1; i < NUM_OF_HOST_PERIPHERALS; i++)
+        {
+            if (eventTimes[i] < eventTimes[first])
+            {
+                first = i;
+            }
+        }
+        const uint64_t time = eventTimes[first];
+        // The peripheral schedules its next event while it runs
+        HostCore_schedule(first, HOST_NEVER);
+        switch (first)
+        {
+        case HOST_SCRIPT:
+            HostScript_run(time);
+            break;
+        case HOST_TIMER_A0:
+        case HOST_TIMER_A1:
+        case HOST_TIMER_A2:
+        case HOST_TIMER_A3:
+            HostTimerA_run(first - HOST_TIMER_A0, time);
+            break;
+        case HOST_TIMER32_1:
+        case HOST_TIMER32_2:
+            HostTimer32_run(first - HOST_TIMER32_1, time);
+            break;
+        case HOST_SYSTICK:
+            HostSysTick_run(time);
+            break;
+        case HOST_UART:
+            HostUART_run(time);
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief This function moves the virtual time forward by MCLK cycles
+ *
+ * \param cycles is the number of MCLK cycles
+ *
+ * \return None
+ */
+void HostCore_advance(uint32_t cycles)
+{
+    const uint32_t mclk = HostClock_getMCLK();
+    cycleCount += cycleCounting ? cycles : 0;
+    cycleRemainder += (uint64_t) cycles * HOST_NS_PER_S;
+    hostNow += cycleRemainder / mclk;
+    cycleRemainder %= mclk;
+    if (hostNow >= nextEvent)
+    {
+        HostCore_runEvents();
+    }
+    if (hostNow > timeLimit)
+    {
+        Host_halt("time limit reached", HOST_EXIT_TIME_LIMIT);
+    }
+}
+
+/*!
+ * \brief This function picks the pending interrupt to take next
+ *
+ * \return the exception number, or -1 if none can preempt what runs now
+ */
+int HostCore_next(void)
+{
+    uint64_t ready = pendingMask & enabledMask;
+    int next = -1;
+    int priority = activePriority;
+    while (ready)
+    {
+        const int interrupt = __builtin_ctzll(ready);
+        ready &= ready - 1;
+        if (priorities[interrupt] < priority)
+        {
+            next = interrupt;
+            priority = priorities[interrupt];
+        }
+    }
+    return next;
+}
+
+/*!
+ * \brief This function runs the handlers of pending interrupts
+ *
+ * Nothing runs while interrupts are masked. A handler can be preempted by an
+ * interrupt of higher priority while it runs. A level-triggered interrupt
+ * whose source is still asserted when its handler returns is pended again.
+ *
+ * \return None
+ */
+void HostCore_dispatch(void)
+{
+    int interrupt;
+    while (!masked && (interrupt = HostCore_next()) >= 0)
+    {
+        const int outerPriority = activePriority;
+        const int outerInterrupt = activeInterrupt;
+        pendingMask &= ~(1ULL << interrupt);
+        activePriority = priorities[interrupt];
+        activeInterrupt = interrupt;
+        HostCore_advance(HOST_ENTRY_CYCLES);
+        vectors[interrupt]();
+        activePriority = outerPriority;
+        activeInterrupt = outerInterrupt;
+        HostCore_update(interrupt);
+    }
+}
+
+void HostCore_call(uint32_t cycles)
+{
+    HostCore_advance(cycles);
+    HostCore_dispatch();
+}
+
+void HostCore_setLevel(int interrupt, HostCore_Level level)
+{
+    levels[interrupt] = level;
+}
+
+void HostCore_request(int interrupt)
+{
+    pendingMask |= 1ULL << interrupt;
+}
+
+void HostCore_update(int interrupt)
+{
+    if (levels[interrupt] && levels[interrupt]())
+    {
+        pendingMask |= 1ULL << interrupt;
+    }
+}
+
+void HostCore_log(FILE *stream, const char *text)
+{
+    fprintf(stream, "[%4llu.%06llu] %s\n",
+            (unsigned long long) (hostNow / HOST_NS_PER_S),
+            (unsigned long long) (hostNow % HOST_NS_PER_S / 1000), text);
+}
+
+/*!
+ * \brief This function prints the virtual time and the LCD
+ *
+ * \param stream is where to print
+ * \param reason is printed after the time
+ *
+ * \return None
+ */
+void HostCore_report(FILE *stream, const char *reason)
+{
+    HostCore_log(stream, reason);
+    HostLCD_print(stream);
+    fflush(stream);
+}
+
+/*!
+ * \brief This function ends the run when the firmware calls abort()
+ *
+ * The firmware aborts on game over.
+ *
+ * \return None
+ */
+void HostCore_aborted(int signal)
+{
+    Host_halt("abort", HOST_EXIT_ABORT);
+}
+
+uint64_t Host_now(void)
+{
+    return hostNow;
+}
+
+/*!
+ * \brief This function fills the noinit section from HOST_NOINIT
+ *
+ * Without the file the section stays zero, like RAM nobody wrote to.
+ *
+ * \return None
+ */
+void HostCore_loadNoinit(void)
+{
+    FILE *file = fopen(noinitPath, "rb");
+    if (file)
+    {
+        fread(__start_noinit, 1, __stop_noinit - __start_noinit, file);
+        fclose(file);
+    }
+}
+
+/*!
+ * \brief This function saves the noinit section to HOST_NOINIT
+ *
+ * The next run starts like the board after a warm reset.
+ *
+ * \return None
+ */
+void HostCore_saveNoinit(void)
+{
+    FILE *file = fopen(noinitPath, "wb");
+    if (!file)
+    {
+        perror(noinitPath);
+        return;
+    }
+    fwrite(__start_noinit, 1, __stop_noinit - __start_noinit, file);
+    fclose(file);
+}
+
+/*!
+ * \brief This function saves the profile to HOST_PROFILE
+ *
+ * The file is the same as a dump of profile saved from the debugger.
+ *
+ * \return None
+ */
+void HostCore_saveProfile(void)
+{
+#ifdef PROFILE_ENABLE
+    FILE *file = fopen(profilePath, "wb");
+    if (!file)
+    {
+        perror(profilePath);
+        return;
+    }
+    fwrite(&profile, 1, sizeof(profile), file);
+    fclose(file);
+#else
+    fprintf(stderr, "HOST_PROFILE: built without PROFILE_ENABLE\n");
+#endif
+}
+
+/*!
+ * \brief This function prints the probes for HOST_PROBES
+ *
+ * \return None
+ */
+void HostCore_printProbes(void)
+{
+#ifdef PROBE_ENABLE
+    static const char *const names[NUM_OF_PROBES] = {
+            "TA3_0", "TA3_N", "PendSV", "PORT1", "PORT4", "DMA_INT1",
+            "DMA_INT2", "ADC14", "password", "lights", "temp", "direction",
+            "power", "reaction", "binary", "keypad scan", "LCD flush",
+            "LCD print", "LCD instruction" };
+    printf("%-16s %8s %10s %10s %10s\n", "probe", "count", "min", "mean",
+           "max");
+    int probe;
+    for (probe = 0; probe < NUM_OF_PROBES; probe++)
+    {
+        const ProbeStats *stats = &probeStats[probe];
+        if (stats->count)
+        {
+            printf("%-16s %8lu %10lu %10llu %10lu\n", names[probe],
+                   (unsigned long) stats->count, (unsigned long) stats->min,
+                   (unsigned long long) (stats->total / stats->count),
+                   (unsigned long) stats->max);
+        }
+    }
+#else
+    fprintf(stderr, "HOST_PROBES: built without PROBE_ENABLE\n");
+#endif
+}
+
+/*!
+ * \brief This function logs the active-mode residency of the game for the
+ *          sweep
+ *
+ * Nothing is logged unless the game was completed.
+ *
+ * \return None
+ */
+void HostCore_logPower(void)
+{
+    if (&gamePowerStats && gamePowerStats.totalTicks)
+    {
+        char line[64];
+        snprintf(line, sizeof(line), "power active %u wakeups %lu",
+                 gamePowerStats.activePercent,
+                 (unsigned long) gamePowerStats.wakeups);
+        HostCore_log(stdout, line);
+    }
+}
+
+void Host_halt(const char *reason, int status)
+{
+    char line[80];
+    HostPlayer_finish();
+    HostCore_logPower();
+    if (noinitPath)
+    {
+        HostCore_saveNoinit();
+    }
+    if (profilePath)
+    {
+        HostCore_saveProfile();
+    }
+    snprintf(line, sizeof(line), "halt: %s", reason);
+    HostCore_report(stdout, line);
+    if (printProbes)
+    {
+        HostCore_printProbes();
+    }
+    exit(status);
+}
+
+/*!
+ * \brief This function gives time() a reproducible virtual clock
+ *
+ * The firmware seeds rand() from time(), HOST_SEED picks the seed.
+ *
+ * \return the seconds since HOST_SEED
+ */
+time_t time(time_t *now)
+{
+    const time_t seconds = timeSeed + hostNow / HOST_NS_PER_S;
+    if (now)
+    {
+        *now = seconds;
+    }
+    return seconds;
+}
+
+/*!
+ * \brief This function resets the simulated board before main runs
+ *
+ * \return None
+ */
+__attribute__((constructor)) void HostCore_init(void)
+{
+    int i;
+    for (i = 0; i < NUM_OF_HOST_PERIPHERALS; i++)
+    {
+        eventTimes[i] = HOST_NEVER;
+    }
+    HostGPIO_init();
+    HostTimerA_init();
+    HostTimer32_init();
+    HostADC_init();
+    HostDMA_init();
+    HostUART_init();
+
+    const char *value;
+    if ((value = getenv("HOST_SEED")) != NULL)
+    {
+        timeSeed = strtoll(value, NULL, 0);
+    }
+    if ((value = getenv("HOST_TIME_LIMIT")) != NULL)
+    {
+        timeLimit = strtoull(value, NULL, 0) * HOST_NS_PER_S;
+    }
+    if ((noinitPath = getenv("HOST_NOINIT")) != NULL)
+    {
+        HostCore_loadNoinit();
+    }
+    profilePath = getenv("HOST_PROFILE");
+    if ((value = getenv("HOST_PROBES")) != NULL)
+    {
+        printProbes = atoi(value) != 0;
+    }
+    if ((value = getenv("HOST_TRACE")) != NULL)
+    {
+        traceLCD = atoi(value) != 0;
+    }
+    if ((value = getenv("HOST_SCRIPT")) != NULL && !Host_loadScript(value))
+    {
+        exit(HOST_EXIT_USAGE);
+    }
+    if ((value = getenv("HOST_PLAYER")) != NULL)
+    {
+        const char *difficulty = getenv("HOST_DIFFICULTY");
+        HostPlayer_start(value, difficulty ? atoi(difficulty) : 0, timeSeed);
+    }
+    signal(SIGABRT, HostCore_aborted);
+}
+
+bool Interrupt_enableMaster(void)
+{
+    HostCore_advance(HOST_CALL_CYCLES);
+    const bool wasMasked = masked;
+    masked = false;
+    HostCore_dispatch();
+    return wasMasked;
+}
+
+bool Interrupt_disableMaster(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    const bool wasMasked = masked;
+    masked = true;
+    return wasMasked;
+}
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber)
+{
+    HostCore_advance(HOST_CALL_CYCLES);
+    enabledMask |= 1ULL << interruptNumber;
+    HostCore_dispatch();
+}
+
+void Interrupt_disableInterrupt(uint32_t interruptNumber)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (interruptNumber != FAULT_PENDSV && interruptNumber != FAULT_SYSTICK)
+    {
+        enabledMask &= ~(1ULL << interruptNumber);
+    }
+}
+
+bool Interrupt_isEnabled(uint32_t interruptNumber)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return (enabledMask & (1ULL << interruptNumber)) != 0;
+}
+
+void Interrupt_pendInterrupt(uint32_t interruptNumber)
+{
+    HostCore_advance(HOST_CALL_CYCLES);
+    HostCore_request(interruptNumber);
+    HostCore_dispatch();
+}
+
+void Interrupt_unpendInterrupt(uint32_t interruptNumber)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    pendingMask &= ~(1ULL << interruptNumber);
+    // A source that is still asserted pends it again right away
+    HostCore_update(interruptNumber);
+}
+
+void Interrupt_setPriority(uint32_t interruptNumber, uint8_t priority)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    // Only the top 3 bits are implemented
+    priorities[interruptNumber] = priority & 0xE0;
+}
+
+bool PCM_gotoLPM0(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (traceLCD && HostLCD_changed())
+    {
+        HostCore_report(stdout, "lcd");
+    }
+    // Like WFI, a pending interrupt wakes the core even while masked
+    while (!(pendingMask & enabledMask))
+    {
+        if (nextEvent == HOST_NEVER)
+        {
+            Host_halt("asleep with nothing left to wake it",
+                      HOST_EXIT_STALLED);
+        }
+        if (nextEvent > timeLimit)
+        {
+            Host_halt("time limit reached", HOST_EXIT_TIME_LIMIT);
+        }
+        if (cycleCounting)
+        {
+            cycleCount += HostCore_timeToTicks(nextEvent - hostNow,
+                                               HostClock_getMCLK());
+        }
+        hostNow = nextEvent;
+        cycleRemainder = 0;
+        HostCore_runEvents();
+    }
+    HostCore_dispatch();
+    return true;
+}
+
+/*!
+ * \brief This function checks whether nothing can wake the core anymore
+ *
+ * The script and the player run forever, but their inputs only wake the core
+ * through the port interrupts.
+ *
+ * \return true if no peripheral has an event left and the ports can't wake
+ *          the core
+ */
+bool HostCore_isDormant(void)
+{
+    int i;
+    for (i = HOST_SCRIPT + 1; i < NUM_OF_HOST_PERIPHERALS; i++)
+    {
+        if (eventTimes[i] != HOST_NEVER)
+        {
+            return false;
+        }
+    }
+    for (i = INT_PORT1; i <= INT_PORT6; i++)
+    {
+        if (enabledMask & (1ULL << i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PCM_gotoLPM3(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (traceLCD && HostLCD_changed())
+    {
+        HostCore_report(stdout, "lcd");
+    }
+    // Timers on ACLK keep counting, so their interrupts still wake the core
+    HostClock_stop(true);
+    while (!(pendingMask & enabledMask))
+    {
+        if (HostCore_isDormant())
+        {
+            Host_halt("asleep in LPM3", HOST_EXIT_DONE);
+        }
+        if (nextEvent > timeLimit)
+        {
+            Host_halt("time limit reached", HOST_EXIT_TIME_LIMIT);
+        }
+        hostNow = nextEvent;
+        cycleRemainder = 0;
+        HostCore_runEvents();
+    }
+    HostClock_stop(false);
+    HostCore_dispatch();
+    return true;
+}
+
+void HAL_startCycleCounter(void)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    cycleCount = 0;
+    cycleCounting = true;
+}
+
+uint32_t HAL_readCycleCount(void)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    return cycleCount;
+}
+
+uint32_t HAL_readInterruptedPC(void)
+{
+    // Below the innermost HostCore_dispatch on the host stack, the first
+    // frame that isn't the simulator's is the code that was interrupted
+    void *frames[MAX_FRAMES];
+    HostCore_advance(HOST_ACCESS_CYCLES);
+    const int depth = backtrace(frames, MAX_FRAMES);
+    bool found = false;
+    int i;
+    for (i = 0; i < depth; i++)
+    {
+        Dl_info info;
+        const char *name =
+                dladdr(frames[i], &info) && info.dli_sname ?
+                        info.dli_sname : "";
+        if (!found)
+        {
+            found = strcmp(name, "HostCore_dispatch") == 0;
+        }
+        else if (strncmp(name, "Host", 4) != 0 && strncmp(name, "HAL_", 4) != 0)
+        {
+            // Back from the return address into the call instruction
+            return (uintptr_t) frames[i] - 1;
+        }
+    }
+    return 0;
+}
+
+void WDT_A_holdTimer(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+}
+
+void PMAP_configurePorts(const uint8_t *portMapping, uint8_t pxMAPy,
+                         uint8_t numberOfPorts, uint8_t portMapReconfigure)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+}
+
+void FPU_enableModule(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+}
@@ -0,0 +1,361 @@
+/*
+ * HostDMA.c
+ *
+ * Description: Helper file for the simulated uDMA controller. A request moves
+ *              up to 2^R elements of the channel's active structure at once.
+ *              When a structure runs out the channel's completion flag is
+ *              set. In ping-pong mode the controller then moves on to the
+ *              other structure.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <string.h>
+
+#define NUM_OF_CHANNELS                                             8
+#define NUM_OF_DMA_INTERRUPTS                                       4
+#define CHANNEL_NONE                                                -1
+#define CHANNEL(index)                                      ((index) & 0x07)
+#define STRUCTURE(index) \
+    (CHANNEL(index) + (((index) & UDMA_ALT_SELECT) ? NUM_OF_CHANNELS : 0))
+/* DMA_INT0 is number 50, DMA_INT3 is 47 */
+#define SLOT(interrupt)                             (INT_DMA_INT0 - (interrupt))
+#define INCREMENT_NONE                                              3
+
+typedef struct _HostDMAStructure
+{
+    uint32_t mode;
+    const volatile uint8_t *src;
+    volatile uint8_t *dst;
+    uint32_t remaining;
+    uint32_t size;          // Bytes per element
+    uint32_t srcStep;       // Bytes between elements
+    uint32_t dstStep;
+    uint32_t arbitration;   // Elements per request
+} HostDMAStructure;
+
+typedef struct _HostDMA
+{
+    bool on;
+    HostDMAStructure structures[2 * NUM_OF_CHANNELS];
+    uint32_t mapping[NUM_OF_CHANNELS];
+    uint32_t enabled;       // One bit per channel
+    uint32_t alternate;     // Channels on their alternate structure
+    uint32_t flags;         // Completed channels
+    int interruptChannel[NUM_OF_DMA_INTERRUPTS];
+    bool interruptEnabled[NUM_OF_DMA_INTERRUPTS];
+} HostDMA;
+
+static HostDMA dma;
+
+/*!
+ * \brief This function gets the number of bytes between elements
+ *
+ * \param code is the 2-bit increment field of the control word
+ * \param size is the 2-bit size field of the control word
+ *
+ * \return the step in bytes
+ */
+uint32_t HostDMA_step(uint32_t code, uint32_t size)
+{
+    // Increments smaller than the element size are raised to it
+    if (code == INCREMENT_NONE)
+    {
+        return 0;
+    }
+    return 1 << (code > size ? code : size);
+}
+
+/*!
+ * \brief This function checks whether a DMA interrupt is asserted
+ *
+ * DMA_INT1 - DMA_INT3 each report one assigned channel. DMA_INT0 reports
+ * every other channel.
+ *
+ * \return true if the interrupt is asserted
+ */
+bool HostDMA_asserted(int slot)
+{
+    if (!dma.interruptEnabled[slot])
+    {
+        return false;
+    }
+    if (slot > 0)
+    {
+        const int channel = dma.interruptChannel[slot];
+        return channel != CHANNEL_NONE && (dma.flags & (1 << channel));
+    }
+    uint32_t others = dma.flags;
+    int i;
+    for (i = 1; i < NUM_OF_DMA_INTERRUPTS; i++)
+    {
+        if (dma.interruptChannel[i] != CHANNEL_NONE)
+        {
+            others &= ~(1 << dma.interruptChannel[i]);
+        }
+    }
+    return others != 0;
+}
+
+bool HostDMA_level0(void)
+{
+    return HostDMA_asserted(0);
+}
+
+bool HostDMA_level1(void)
+{
+    return HostDMA_asserted(1);
+}
+
+bool HostDMA_level2(void)
+{
+    return HostDMA_asserted(2);
+}
+
+bool HostDMA_level3(void)
+{
+    return HostDMA_asserted(3);
+}
+
+/*!
+ * \brief This function updates the four DMA interrupts
+ *
+ * \return None
+ */
+void HostDMA_update(void)
+{
+    int slot;
+    for (slot = 0; slot < NUM_OF_DMA_INTERRUPTS; slot++)
+    {
+        HostCore_update(INT_DMA_INT0 - slot);
+    }
+}
+
+/*!
+ * \brief This function serves one request of a channel
+ *
+ * \param channel is the channel number
+ * \param all is true for software requests in auto mode, which move the
+ *          whole transfer
+ *
+ * \return None
+ */
+void HostDMA_transfer(int channel, bool all)
+{
+    const int index = channel
+            + ((dma.alternate & (1 << channel)) ? NUM_OF_CHANNELS : 0);
+    HostDMAStructure *s = &dma.structures[index];
+    if (!dma.on || !(dma.enabled & (1 << channel))
+            || s->mode == UDMA_MODE_STOP)
+    {
+        return;
+    }
+    uint32_t count = all || s->mode == UDMA_MODE_AUTO ?
+            s->remaining : s->arbitration;
+    if (count > s->remaining)
+    {
+        count = s->remaining;
+    }
+    while (count--)
+    {
+        memcpy((void*) s->dst, (const void*) s->src, s->size);
+        HostADC_resultRead(s->src);
+        HostUART_written(s->dst);
+        s->src += s->srcStep;
+        s->dst += s->dstStep;
+        s->remaining--;
+    }
+    if (s->remaining)
+    {
+        return;
+    }
+
+    dma.flags |= 1 << channel;
+    if (s->mode == UDMA_MODE_PINGPONG)
+    {
+        s->mode = UDMA_MODE_STOP;
+        dma.alternate ^= 1 << channel;
+        const int other = index ^ NUM_OF_CHANNELS;
+        if (dma.structures[other].mode == UDMA_MODE_STOP)
+        {
+            dma.enabled &= ~(1 << channel);
+        }
+    }
+    else
+    {
+        s->mode = UDMA_MODE_STOP;
+        dma.enabled &= ~(1 << channel);
+    }
+    HostDMA_update();
+}
+
+void HostDMA_init(void)
+{
+    int slot;
+    for (slot = 0; slot < NUM_OF_DMA_INTERRUPTS; slot++)
+    {
+        dma.interruptChannel[slot] = CHANNEL_NONE;
+    }
+    HostCore_setLevel(INT_DMA_INT0, HostDMA_level0);
+    HostCore_setLevel(INT_DMA_INT1, HostDMA_level1);
+    HostCore_setLevel(INT_DMA_INT2, HostDMA_level2);
+    HostCore_setLevel(INT_DMA_INT3, HostDMA_level3);
+}
+
+void HostDMA_request(uint32_t mapping)
+{
+    const int channel = CHANNEL(mapping);
+    if (dma.mapping[channel] == mapping)
+    {
+        HostDMA_transfer(channel, false);
+    }
+}
+
+bool HostDMA_isMapped(uint32_t mapping)
+{
+    return dma.mapping[CHANNEL(mapping)] == mapping;
+}
+
+void DMA_enableModule(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.on = true;
+}
+
+void DMA_disableModule(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.on = false;
+}
+
+void DMA_setControlBase(void *controlTable)
+{
+    // The structures are kept here, the table is never read
+    HostCore_call(HOST_CALL_CYCLES);
+}
+
+void DMA_assignChannel(uint32_t mapping)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    HostTimerA_watchChanging();
+    dma.mapping[CHANNEL(mapping)] = mapping;
+    HostTimerA_watchChanged();
+}
+
+void DMA_enableChannel(uint32_t channelNum)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.enabled |= 1 << CHANNEL(channelNum);
+}
+
+void DMA_disableChannel(uint32_t channelNum)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.enabled &= ~(1 << CHANNEL(channelNum));
+}
+
+bool DMA_isChannelEnabled(uint32_t channelNum)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return (dma.enabled & (1 << CHANNEL(channelNum))) != 0;
+}
+
+void DMA_enableChannelAttribute(uint32_t channelNum, uint32_t attr)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (attr & UDMA_ATTR_ALTSELECT)
+    {
+        dma.alternate |= 1 << CHANNEL(channelNum);
+    }
+}
+
+void DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (attr & UDMA_ATTR_ALTSELECT)
+    {
+        dma.alternate &= ~(1 << CHANNEL(channelNum));
+    }
+}
+
+uint32_t DMA_getChannelAttribute(uint32_t channelNum)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return (dma.alternate & (1 << CHANNEL(channelNum))) ?
+            UDMA_ATTR_ALTSELECT : 0;
+}
+
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    HostDMAStructure *s = &dma.structures[STRUCTURE(channelStructIndex)];
+    const uint32_t size = (control >> 24) & 0x03;
+    s->size = 1 << size;
+    s->srcStep = HostDMA_step((control >> 26) & 0x03, size);
+    s->dstStep = HostDMA_step((control >> 30) & 0x03, size);
+    s->arbitration = 1 << ((control >> 14) & 0x0F);
+}
+
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                            void *srcAddr, void *dstAddr,
+                            uint32_t transferSize)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    HostDMAStructure *s = &dma.structures[STRUCTURE(channelStructIndex)];
+    s->mode = mode;
+    s->src = srcAddr;
+    s->dst = dstAddr;
+    s->remaining = transferSize;
+}
+
+uint32_t DMA_getChannelMode(uint32_t channelStructIndex)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return dma.structures[STRUCTURE(channelStructIndex)].mode;
+}
+
+uint32_t DMA_getChannelSize(uint32_t channelStructIndex)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return dma.structures[STRUCTURE(channelStructIndex)].remaining;
+}
+
+void DMA_requestSoftwareTransfer(uint32_t channel)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    HostDMA_transfer(CHANNEL(channel), true);
+}
+
+void DMA_assignInterrupt(uint32_t interruptNumber, uint32_t channel)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.interruptChannel[SLOT(interruptNumber)] = CHANNEL(channel);
+}
+
+void DMA_enableInterrupt(uint32_t interruptNumber)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.interruptEnabled[SLOT(interruptNumber)] = true;
+    HostDMA_update();
+}
+
+void DMA_disableInterrupt(uint32_t interruptNumber)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.interruptEnabled[SLOT(interruptNumber)] = false;
+}
+
+uint32_t DMA_getInterruptStatus(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return dma.flags;
+}
+
+void DMA_clearInterruptFlag(uint32_t intChannel)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    dma.flags &= ~(1 << CHANNEL(intChannel));
+}
@@ -0,0 +1,321 @@
+/*
+ * HostGPIO.c
+ *
+ * Description: Helper file for the simulated ports P1 - P10 and PJ and what
+ *              is wired to them: the switches on P1.1, P1.4 and P1.5, the
+ *              keypad rows on P4.0-3 and columns on P4.4-7, and the LCD on
+ *              P3 and P6. Pressed switches and keys pull their input low,
+ *              and the LCD drives P6.4-7 while it is read.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define NUM_OF_PORTS                                                12
+#define KEYPAD_ROWS                                                 4
+#define KEYPAD_COLUMNS                                              4
+#define KEYPAD_ROW_PINS                                             0x0F
+
+typedef struct _HostPort
+{
+    uint8_t out;
+    uint8_t dir;
+    uint8_t ren;
+    uint8_t sel;
+    uint8_t ies;
+    uint8_t ie;
+    uint8_t ifg;
+    uint8_t in;
+} HostPort;
+
+/* Indexed by GPIO_PORT_Px */
+static HostPort ports[NUM_OF_PORTS];
+
+/* Keys down, one bit per row * 4 + column */
+static uint16_t keysDown = 0;
+/* P1 pins whose switch is pressed */
+static uint8_t switchesDown = 0;
+
+static const char keys[] = "123A456B789C*0#D";
+
+/*!
+ * \brief This function gets the pins of a port pulled low from outside
+ *
+ * \return the pins held low by a switch or a key
+ */
+uint8_t HostGPIO_pulledLow(int port)
+{
+    if (port == GPIO_PORT_P1)
+    {
+        return switchesDown;
+    }
+    if (port != GPIO_PORT_P4)
+    {
+        return 0;
+    }
+    // A key connects its row to its column, column c is on P4.(7 - c)
+    const uint8_t rowsLow = ports[port].dir & ~ports[port].out
+            & KEYPAD_ROW_PINS;
+    uint8_t low = 0;
+    int key;
+    for (key = 0; key < KEYPAD_ROWS * KEYPAD_COLUMNS; key++)
+    {
+        if ((keysDown & (1 << key)) && (rowsLow & (1 << (key / 4))))
+        {
+            low |= 0x80 >> (key % 4);
+        }
+    }
+    return low;
+}
+
+/*!
+ * \brief This function updates the input register of a port
+ *
+ * Edges on pins with interrupts set their flag, like PxIFG.
+ *
+ * \return None
+ */
+void HostGPIO_update(int port)
+{
+    HostPort *p = &ports[port];
+    // Outputs read back, pulled inputs follow PxOUT, floating inputs read 0
+    uint8_t in = (p->dir & p->out) | (~p->dir & p->ren & p->out);
+    in &= ~(~p->dir & HostGPIO_pulledLow(port));
+    if (port == GPIO_PORT_P6)
+    {
+        // The LCD drives DB4-7 during a read
+        uint8_t pins;
+        const uint8_t value = HostLCD_driven(&pins);
+        pins &= ~p->dir;
+        in = (in & ~pins) | (value & pins);
+    }
+    const uint8_t rising = in & ~p->in;
+    const uint8_t falling = ~in & p->in;
+    p->in = in;
+    p->ifg |= (rising & ~p->ies) | (falling & p->ies);
+    if (port <= GPIO_PORT_P6)
+    {
+        HostCore_update(INT_PORT1 + port - 1);
+    }
+}
+
+/*!
+ * \brief This function gets a port and charges the call
+ *
+ * \return the port
+ */
+HostPort* HostGPIO_get(uint_fast8_t port)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return &ports[port];
+}
+
+/*!
+ * \brief This function finishes a write to a port
+ *
+ * \return None
+ */
+void HostGPIO_written(uint_fast8_t port)
+{
+    HostGPIO_update(port);
+    if (port == GPIO_PORT_P3)
+    {
+        HostLCD_strobe(ports[GPIO_PORT_P3].out, ports[GPIO_PORT_P6].out);
+        HostGPIO_update(GPIO_PORT_P6);
+    }
+}
+
+/* Level of the interrupt of each port with interrupts */
+#define PORT_LEVEL(n) \
+    bool HostGPIO_level##n(void) \
+    { \
+        return (ports[n].ifg & ports[n].ie) != 0; \
+    }
+
+PORT_LEVEL(1)
+PORT_LEVEL(2)
+PORT_LEVEL(3)
+PORT_LEVEL(4)
+PORT_LEVEL(5)
+PORT_LEVEL(6)
+
+void HostGPIO_init(void)
+{
+    HostCore_setLevel(INT_PORT1, HostGPIO_level1);
+    HostCore_setLevel(INT_PORT2, HostGPIO_level2);
+    HostCore_setLevel(INT_PORT3, HostGPIO_level3);
+    HostCore_setLevel(INT_PORT4, HostGPIO_level4);
+    HostCore_setLevel(INT_PORT5, HostGPIO_level5);
+    HostCore_setLevel(INT_PORT6, HostGPIO_level6);
+}
+
+bool Host_setKey(char key, bool pressed)
+{
+    int index;
+    for (index = 0; keys[index]; index++)
+    {
+        if (keys[index] == key)
+        {
+            if (pressed)
+            {
+                keysDown |= 1 << index;
+            }
+            else
+            {
+                keysDown &= ~(1 << index);
+            }
+            HostGPIO_update(GPIO_PORT_P4);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Host_setSwitch(int pin, bool pressed)
+{
+    if (pressed)
+    {
+        switchesDown |= 1 << pin;
+    }
+    else
+    {
+        switchesDown &= ~(1 << pin);
+    }
+    HostGPIO_update(GPIO_PORT_P1);
+}
+
+bool Host_readPin(int port, int pin)
+{
+    return (ports[port].dir & ports[port].out & pin) != 0;
+}
+
+uint8_t HAL_readPort(uint_fast8_t port)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    return ports[port].in;
+}
+
+void GPIO_setAsOutputPin(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel &= ~pins;
+    p->dir |= pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setOutputHighOnPin(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->out |= pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setOutputLowOnPin(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->out &= ~pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_toggleOutputOnPin(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->out ^= pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setAsInputPin(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel &= ~pins;
+    p->dir &= ~pins;
+    p->ren &= ~pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t port,
+                                          uint_fast16_t pins)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel &= ~pins;
+    p->dir &= ~pins;
+    p->ren |= pins;
+    p->out |= pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setAsInputPinWithPullDownResistor(uint_fast8_t port,
+                                            uint_fast16_t pins)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel &= ~pins;
+    p->dir &= ~pins;
+    p->ren |= pins;
+    p->out &= ~pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t port,
+                                                 uint_fast16_t pins,
+                                                 uint_fast8_t mode)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel |= pins;
+    p->dir |= pins;
+    HostGPIO_written(port);
+}
+
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t port,
+                                                uint_fast16_t pins,
+                                                uint_fast8_t mode)
+{
+    HostPort *p = HostGPIO_get(port);
+    p->sel |= pins;
+    p->dir &= ~pins;
+    HostGPIO_written(port);
+}
+
+uint8_t GPIO_getInputPinValue(uint_fast8_t port, uint_fast16_t pin)
+{
+    return (HostGPIO_get(port)->in & pin) ?
+            GPIO_INPUT_PIN_HIGH : GPIO_INPUT_PIN_LOW;
+}
+
+void GPIO_interruptEdgeSelect(uint_fast8_t port, uint_fast16_t pins,
+                              uint_fast8_t edgeSelect)
+{
+    HostPort *p = HostGPIO_get(port);
+    if (edgeSelect == GPIO_HIGH_TO_LOW_TRANSITION)
+    {
+        p->ies |= pins;
+    }
+    else
+    {
+        p->ies &= ~pins;
+    }
+}
+
+void GPIO_enableInterrupt(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->ie |= pins;
+    HostGPIO_update(port);
+}
+
+void GPIO_disableInterrupt(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->ie &= ~pins;
+}
+
+void GPIO_clearInterruptFlag(uint_fast8_t port, uint_fast16_t pins)
+{
+    HostGPIO_get(port)->ifg &= ~pins;
+}
+
+uint_fast16_t GPIO_getInterruptStatus(uint_fast8_t port, uint_fast16_t pins)
+{
+    return HostGPIO_get(port)->ifg & pins;
+}
+
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t port)
+{
+    const HostPort *p = HostGPIO_get(port);
+    return p->ifg & p->ie;
+}
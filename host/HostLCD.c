@@ -0,0 +1,281 @@
+/*
+ * HostLCD.c
+ *
+ * Description: Helper file for the simulated HD44780 LCD. E is on P3.2, RS
+ *              on P3.3 and DB4-7 on P6.4-7. DB4-7 are latched when E falls.
+ *              The board ties R/W low. A build that wires it to P3.4 can
+ *              read the busy flag and address counter, which the LCD drives
+ *              on DB4-7 while E is high. Each instruction keeps the LCD busy
+ *              for its typical execution time. Characters are printed as
+ *              ASCII, and the degree sign 0xDF is printed as UTF-8.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <string.h>
+
+#define E_PIN                                                       GPIO_PIN2
+#define RS_PIN                                                      GPIO_PIN3
+#define RW_PIN                                                      GPIO_PIN4
+#define BUSY_FLAG                                                   0x80
+/* Typical execution times at 270 kHz, HD44780 data sheet Table 6 */
+#define SHORT_EXECUTION_NS                                          37000
+#define LONG_EXECUTION_NS                                           1520000
+#define DDRAM_SIZE                                                  0x80
+#define LINE_LENGTH                                                 0x28
+#define LINE2_START                                                 0x40
+#define COLUMNS                                                     16
+#define DEGREE_SIGN                                                 0xDF
+
+typedef struct _HostLCD
+{
+    uint8_t ddram[DDRAM_SIZE];
+    uint8_t address;
+    bool fourBit;           // Set by function set, power-on is 8-bit
+    bool secondNibble;      // The high nibble of a 4-bit pair was latched
+    uint8_t high;           // The latched high nibble
+    bool increment;
+    bool cgram;             // Data goes to CGRAM, which isn't shown
+    bool displayOn;
+    bool lastE;
+    bool changed;           // Something shown changed since the last check
+    uint64_t busyUntil;     // Virtual time the last instruction is done at
+    bool driving;           // A read has DB4-7 driven by the LCD
+    bool secondRead;        // The high nibble of a 4-bit read was read
+    uint8_t status;         // Busy flag and address counter being read
+} HostLCD;
+
+static HostLCD lcd = { .increment = true };
+
+/*!
+ * \brief This function moves the address counter by one
+ *
+ * Line 1 is 0x00 - 0x27 and line 2 is 0x40 - 0x67, each wraps to the other.
+ *
+ * \return None
+ */
+void HostLCD_step(void)
+{
+    if (lcd.increment)
+    {
+        lcd.address++;
+        if (lcd.address == LINE_LENGTH)
+        {
+            lcd.address = LINE2_START;
+        }
+        else if (lcd.address == LINE2_START + LINE_LENGTH)
+        {
+            lcd.address = 0;
+        }
+    }
+    else
+    {
+        if (lcd.address == 0)
+        {
+            lcd.address = LINE2_START + LINE_LENGTH;
+        }
+        else if (lcd.address == LINE2_START)
+        {
+            lcd.address = LINE_LENGTH;
+        }
+        lcd.address--;
+    }
+}
+
+/*!
+ * \brief This function runs an instruction
+ *
+ * \param rs is true for data, false for a command
+ * \param value is the instruction byte
+ *
+ * \return None
+ */
+void HostLCD_execute(bool rs, uint8_t value)
+{
+    // Clear display and return home are the long instructions
+    lcd.busyUntil = hostNow
+            + (!rs && value < 0x04 && value ? LONG_EXECUTION_NS :
+                    SHORT_EXECUTION_NS);
+    if (rs)
+    {
+        if (!lcd.cgram)
+        {
+            lcd.ddram[lcd.address & (DDRAM_SIZE - 1)] = value;
+            lcd.changed = true;
+            HostLCD_step();
+        }
+        return;
+    }
+    if (value & 0x80)
+    {
+        lcd.cgram = false;
+        lcd.address = value & 0x7F;
+    }
+    else if (value & 0x40)
+    {
+        lcd.cgram = true;
+    }
+    else if (value & 0x20)
+    {
+        lcd.fourBit = !(value & 0x10);
+    }
+    else if (value & 0x10)
+    {
+        // Cursor and display shift, the display is never shifted here
+    }
+    else if (value & 0x08)
+    {
+        lcd.displayOn = (value & 0x04) != 0;
+        lcd.changed = true;
+    }
+    else if (value & 0x04)
+    {
+        lcd.increment = (value & 0x02) != 0;
+    }
+    else if (value & 0x02)
+    {
+        lcd.cgram = false;
+        lcd.address = 0;
+    }
+    else if (value & 0x01)
+    {
+        memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+        lcd.cgram = false;
+        lcd.address = 0;
+        lcd.increment = true;
+        lcd.changed = true;
+    }
+}
+
+/*!
+ * \brief This function starts a read of the busy flag and address counter
+ *
+ * The byte is taken when E rises for its high nibble. Only reads with RS low
+ * are simulated.
+ *
+ * \return None
+ */
+void HostLCD_read(void)
+{
+    if (!lcd.secondRead)
+    {
+        lcd.status = (hostNow < lcd.busyUntil ? BUSY_FLAG : 0)
+                | (lcd.address & 0x7F);
+    }
+    lcd.driving = true;
+}
+
+void HostLCD_strobe(uint8_t port3, uint8_t port6)
+{
+    const bool e = (port3 & E_PIN) != 0;
+    const bool rising = !lcd.lastE && e;
+    const bool falling = lcd.lastE && !e;
+    lcd.lastE = e;
+    if (port3 & RW_PIN)
+    {
+        if (rising)
+        {
+            HostLCD_read();
+        }
+        else if (falling)
+        {
+            lcd.driving = false;
+            lcd.secondRead = lcd.fourBit && !lcd.secondRead;
+        }
+        return;
+    }
+    if (!falling)
+    {
+        return;
+    }
+    lcd.secondRead = false;
+    const bool rs = (port3 & RS_PIN) != 0;
+    const uint8_t nibble = port6 >> 4;
+    if (!lcd.fourBit)
+    {
+        // DB0-3 aren't wired and read as 0
+        HostLCD_execute(rs, nibble << 4);
+    }
+    else if (!lcd.secondNibble)
+    {
+        lcd.high = nibble;
+        lcd.secondNibble = true;
+    }
+    else
+    {
+        lcd.secondNibble = false;
+        HostLCD_execute(rs, lcd.high << 4 | nibble);
+    }
+}
+
+/*!
+ * \brief This function gets what the LCD drives on P6
+ *
+ * \param pins is where the mask of the pins driven is stored
+ *
+ * \return the level of the pins driven
+ */
+uint8_t HostLCD_driven(uint8_t *pins)
+{
+    if (!lcd.driving)
+    {
+        *pins = 0;
+        return 0;
+    }
+    *pins = 0xF0;
+    return lcd.secondRead ? lcd.status << 4 : lcd.status & 0xF0;
+}
+
+bool HostLCD_changed(void)
+{
+    const bool changed = lcd.changed;
+    lcd.changed = false;
+    return changed;
+}
+
+void HostLCD_print(FILE *stream)
+{
+    char lines[2][17];
+    Host_readLCD(lines);
+    fprintf(stream, "+----------------+\n");
+    int line;
+    for (line = 0; line < 2; line++)
+    {
+        fputc('|', stream);
+        int column;
+        for (column = 0; column < COLUMNS; column++)
+        {
+            const uint8_t c = lines[line][column];
+            if (c == DEGREE_SIGN)
+            {
+                fputs("°", stream);
+            }
+            else
+            {
+                fputc(c >= ' ' && c < 0x7F ? c : '?', stream);
+            }
+        }
+        fputs("|\n", stream);
+    }
+    fprintf(stream, "+----------------+\n");
+}
+
+void Host_readLCD(char lines[2][17])
+{
+    int line;
+    for (line = 0; line < 2; line++)
+    {
+        if (lcd.displayOn)
+        {
+            memcpy(lines[line], &lcd.ddram[line * LINE2_START], COLUMNS);
+        }
+        else
+        {
+            memset(lines[line], ' ', COLUMNS);
+        }
+        lines[line][COLUMNS] = '\0';
+    }
+}
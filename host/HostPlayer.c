@@ -0,0 +1,565 @@
+/*
+ * HostPlayer.c
+ *
+ * Description: Helper file for the simulated player. The player only sees
+ *              what a person would: the LCD and the external LEDs, looked at
+ *              every POLL_MS. It answers each screen with the keypad,
+ *              switches, pot, thermistor and photoresistor after a random
+ *              reaction time, and sometimes makes a mistake. Its random
+ *              numbers are its own, so the firmware's rand() is untouched.
+ *
+ *              The time of each task, from its prompt to the next screen,
+ *              and the end of the game are logged for the sweep.
+ *
+ *  Created on: Mar 7, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POLL_MS                                                     10
+#define HOLD_MS                                                     80
+#define DEFAULT_REACTION_MS                                         300
+#define DEFAULT_MISTAKE_PERCENT                                     5
+/* Readings with nobody touching the sensors, see HostADC_init */
+#define AMBIENT_LIGHT                                               9000
+#define AMBIENT_TEMP                                                6000
+#define FULL_SCALE                                                  0x3FFF
+/* Counts the photoresistor misses the dark by on the first try */
+#define COVER_SPREAD                                                1500
+/* Counts the thermistor drops every 100 ms while held */
+#define WARM_MIN                                                    3
+#define WARM_MAX                                                    9
+/* Pot counts turned per poll, and the spread of the first aim */
+#define TURN_RATE                                                   160
+#define AIM_SIGMA                                                   300
+/* Tasks.c: counts per 10 degrees, and a pot count in millivolts */
+#define ANGLE_STEP                                                  910
+#define FULL_SCALE_MV                                               3300
+
+/* Screens the player tells apart, the tasks first in the order of Tasks */
+typedef enum _PlayerScreen
+{
+    SCREEN_PASSWORD, SCREEN_LIGHTS, SCREEN_TEMP, SCREEN_DIRECTION,
+    SCREEN_POWER, SCREEN_REACTION, SCREEN_BINARY, NUM_OF_TASK_SCREENS,
+    SCREEN_DIFFICULTY = NUM_OF_TASK_SCREENS, SCREEN_DONE, SCREEN_FIRED,
+    SCREEN_OTHER
+} PlayerScreen;
+
+typedef struct _ScreenPrompt
+{
+    PlayerScreen screen;
+    int line;
+    const char *text;       // What the line starts with
+} ScreenPrompt;
+
+static const ScreenPrompt prompts[] = {
+        { SCREEN_DIFFICULTY, 1, "S1:select S2:set" },
+        { SCREEN_PASSWORD, 0, "Enter password:" },
+        { SCREEN_LIGHTS, 0, "Turn off the" },
+        { SCREEN_TEMP, 0, "Turn up the" },
+        { SCREEN_DIRECTION, 0, "Set direction to" },
+        { SCREEN_POWER, 0, "Set power to" },
+        { SCREEN_REACTION, 0, "Press button" },
+        { SCREEN_BINARY, 0, "Press the right" },
+        { SCREEN_DONE, 0, "Good job!" },
+        { SCREEN_FIRED, 0, "You're fired!" } };
+
+static const char *const taskNames[NUM_OF_TASK_SCREENS] = {
+        "password", "lights", "temp", "direction", "power", "reaction",
+        "binary" };
+
+/* External LEDs on P3 in the order of the Reaction task: Y, B, G, R */
+static const uint8_t ledPins[4] = { GPIO_PIN0, GPIO_PIN5, GPIO_PIN6,
+                                    GPIO_PIN7 };
+
+typedef struct _HostPlayer
+{
+    bool on;
+    int difficulty;
+    uint32_t reactionMs;
+    uint32_t mistakePercent;
+    uint64_t random;
+    PlayerScreen screen;
+    uint64_t screenStart;
+    uint64_t busyUntil;     // Nothing new is done before this time
+    int attempts;           // Tries at the current screen
+    int pot;
+    int aim;                // Pot count being turned to
+    int temp;
+    bool ledOn;             // The LED of the Reaction task was on last poll
+} HostPlayer;
+
+static HostPlayer player;
+
+/*!
+ * \brief This function gets the next random number of the player
+ *
+ * This is xorshift64*, which is plenty for modelling people.
+ *
+ * \return a random 32-bit number
+ */
+uint32_t HostPlayer_random(void)
+{
+    player.random ^= player.random >> 12;
+    player.random ^= player.random << 25;
+    player.random ^= player.random >> 27;
+    return (player.random * 0x2545F4914F6CDD1DULL) >> 32;
+}
+
+/*!
+ * \brief This function gets a random number from 0 to n - 1
+ *
+ * \return the number
+ */
+int HostPlayer_uniform(int n)
+{
+    return n > 0 ? HostPlayer_random() % n : 0;
+}
+
+/*!
+ * \brief This function gets a roughly normal random number
+ *
+ * The sum of 12 uniform numbers is close enough to a bell curve.
+ *
+ * \param mean is the middle of the curve
+ * \param sigma is the standard deviation
+ *
+ * \return the number
+ */
+int HostPlayer_normal(int mean, int sigma)
+{
+    double sum = 0;
+    int i;
+    for (i = 0; i < 12; i++)
+    {
+        sum += HostPlayer_random() / 4294967296.0;
+    }
+    return mean + (int) ((sum - 6) * sigma);
+}
+
+/*!
+ * \brief This function decides whether the player gets something wrong
+ *
+ * \return true for a mistake
+ */
+bool HostPlayer_mistake(void)
+{
+    return HostPlayer_uniform(100) < (int) player.mistakePercent;
+}
+
+/*!
+ * \brief This function gets the time the player takes to react
+ *
+ * \return the reaction time in nanoseconds
+ */
+uint64_t HostPlayer_reaction(void)
+{
+    int ms = HostPlayer_normal(player.reactionMs, player.reactionMs / 5);
+    if (ms < 100)
+    {
+        ms = 100;
+    }
+    return ms * HOST_NS_PER_MS;
+}
+
+void HostPlayer_pressKey(void *arg)
+{
+    Host_setKey((char) (intptr_t) arg, true);
+}
+
+void HostPlayer_releaseKey(void *arg)
+{
+    Host_setKey((char) (intptr_t) arg, false);
+}
+
+void HostPlayer_pressSwitch(void *arg)
+{
+    Host_setSwitch((int) (intptr_t) arg, true);
+}
+
+void HostPlayer_releaseSwitch(void *arg)
+{
+    Host_setSwitch((int) (intptr_t) arg, false);
+}
+
+/*!
+ * \brief This function presses and releases a key
+ *
+ * \param time is when the key goes down
+ * \param key is the character on the key
+ *
+ * \return None
+ */
+void HostPlayer_key(uint64_t time, char key)
+{
+    Host_at(time, HostPlayer_pressKey, (void*) (intptr_t) key);
+    Host_at(time + HOLD_MS * HOST_NS_PER_MS, HostPlayer_releaseKey,
+            (void*) (intptr_t) key);
+}
+
+/*!
+ * \brief This function presses and releases a switch
+ *
+ * \param time is when the switch goes down
+ * \param pin is the pin of the switch
+ *
+ * \return None
+ */
+void HostPlayer_switch(uint64_t time, int pin)
+{
+    Host_at(time, HostPlayer_pressSwitch, (void*) (intptr_t) pin);
+    Host_at(time + HOLD_MS * HOST_NS_PER_MS, HostPlayer_releaseSwitch,
+            (void*) (intptr_t) pin);
+}
+
+/*!
+ * \brief This function works out which screen the LCD shows
+ *
+ * \return the screen
+ */
+PlayerScreen HostPlayer_screen(char lines[2][17])
+{
+    int i;
+    for (i = 0; i < sizeof(prompts) / sizeof(prompts[0]); i++)
+    {
+        const char *text = prompts[i].text;
+        if (strncmp(lines[prompts[i].line], text, strlen(text)) == 0)
+        {
+            return prompts[i].screen;
+        }
+    }
+    return SCREEN_OTHER;
+}
+
+/*!
+ * \brief This function reads a number off the LCD, skipping a decimal point
+ *
+ * \return the number
+ */
+int HostPlayer_number(const char *text, int length)
+{
+    int value = 0;
+    int i;
+    for (i = 0; i < length; i++)
+    {
+        if (text[i] >= '0' && text[i] <= '9')
+        {
+            value = value * 10 + text[i] - '0';
+        }
+    }
+    return value;
+}
+
+/*!
+ * \brief This function reads the target and current pot counts off the
+ *          Direction or Power screen
+ *
+ * \param target gets the middle of the target
+ * \param current gets the middle of what is shown
+ *
+ * \return None
+ */
+void HostPlayer_readPot(char lines[2][17], int *target, int *current)
+{
+    if (player.screen == SCREEN_DIRECTION)
+    {
+        // T:090° C:120°, in 10 degree buckets
+        *target = HostPlayer_number(&lines[1][2], 3) / 10 * ANGLE_STEP
+                + ANGLE_STEP / 2;
+        *current = HostPlayer_number(&lines[1][9], 3) / 10 * ANGLE_STEP
+                + ANGLE_STEP / 2;
+    }
+    else
+    {
+        // T:1.65V C:0.80V
+        *target = HostPlayer_number(&lines[1][2], 4) * 10 * (FULL_SCALE + 1)
+                / FULL_SCALE_MV;
+        *current = HostPlayer_number(&lines[1][10], 4) * 10
+                * (FULL_SCALE + 1) / FULL_SCALE_MV;
+    }
+}
+
+/*!
+ * \brief This function gets the value of the hex LEDs
+ *
+ * \return the value, P3.0 is bit 0 and P3.5 - P3.7 are bits 1 - 3
+ */
+int HostPlayer_readHex(void)
+{
+    int value = 0;
+    int bit;
+    for (bit = 0; bit < 4; bit++)
+    {
+        if (Host_readPin(GPIO_PORT_P3, ledPins[bit]))
+        {
+            value |= 1 << bit;
+        }
+    }
+    return value;
+}
+
+/*!
+ * \brief This function logs a line with the virtual time for the sweep
+ *
+ * \return None
+ */
+void HostPlayer_log(const char *format, ...)
+{
+    char line[64];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    HostCore_log(stdout, line);
+}
+
+/*!
+ * \brief This function starts on a new screen
+ *
+ * The task that was up is logged as done, and the sensors are let go.
+ *
+ * \return None
+ */
+void HostPlayer_enter(PlayerScreen screen)
+{
+    if (player.screen < NUM_OF_TASK_SCREENS)
+    {
+        HostPlayer_log("player task %s %llu", taskNames[player.screen],
+                       (unsigned long long) ((hostNow - player.screenStart)
+                               / HOST_NS_PER_MS));
+    }
+    if (player.screen == SCREEN_LIGHTS)
+    {
+        Host_setAnalog(ADC_INPUT_A5, AMBIENT_LIGHT);
+    }
+    if (player.screen == SCREEN_TEMP)
+    {
+        player.temp = AMBIENT_TEMP;
+        Host_setAnalog(ADC_INPUT_A4, player.temp);
+    }
+    player.screen = screen;
+    player.screenStart = hostNow;
+    player.attempts = 0;
+    player.ledOn = false;
+    player.aim = player.pot;
+    // Reading the new screen takes a reaction time, except that the
+    // Reaction task is all about the time to react to its LEDs
+    player.busyUntil = hostNow;
+    if (screen != SCREEN_REACTION)
+    {
+        player.busyUntil += HostPlayer_reaction();
+    }
+}
+
+/*!
+ * \brief This function acts on the screen once the player is ready
+ *
+ * \return None
+ */
+void HostPlayer_act(char lines[2][17])
+{
+    const uint64_t reaction = HostPlayer_reaction();
+    int i;
+    switch (player.screen)
+    {
+    case SCREEN_DIFFICULTY:
+    {
+        // The first S1 shows Easy, each one after that moves on by one
+        uint64_t time = hostNow;
+        for (i = 0; i <= player.difficulty; i++)
+        {
+            HostPlayer_switch(time, 1);
+            time += HostPlayer_reaction();
+        }
+        HostPlayer_switch(time, 4);
+        player.busyUntil = HOST_NEVER;
+        break;
+    }
+    case SCREEN_PASSWORD:
+    {
+        uint64_t time = hostNow;
+        for (i = 0; i < 8 && lines[1][i] != ' '; i++)
+        {
+            if (HostPlayer_mistake())
+            {
+                HostPlayer_key(time, lines[1][i] == '1' ? '2' : '1');
+                time += HostPlayer_reaction();
+            }
+            HostPlayer_key(time, lines[1][i]);
+            time += HostPlayer_reaction() / 2;
+        }
+        player.busyUntil = HOST_NEVER;
+        break;
+    }
+    case SCREEN_LIGHTS:
+        // Each try covers the photoresistor better
+        Host_setAnalog(
+                ADC_INPUT_A5,
+                FULL_SCALE - HostPlayer_uniform(COVER_SPREAD >> player.attempts));
+        player.attempts++;
+        player.busyUntil = hostNow + 2 * reaction;
+        break;
+    case SCREEN_TEMP:
+        player.temp -= WARM_MIN + HostPlayer_uniform(WARM_MAX - WARM_MIN + 1);
+        Host_setAnalog(ADC_INPUT_A4, player.temp);
+        player.busyUntil = hostNow + 100 * HOST_NS_PER_MS;
+        break;
+    case SCREEN_DIRECTION:
+    case SCREEN_POWER:
+    {
+        if (player.pot == player.aim)
+        {
+            // Look at the display and aim again, a bit closer each time
+            int target, current;
+            HostPlayer_readPot(lines, &target, &current);
+            player.aim = player.pot + target - current
+                    + HostPlayer_normal(0, AIM_SIGMA >> player.attempts);
+            player.aim = player.aim < 0 ? 0 :
+                         player.aim > FULL_SCALE ? FULL_SCALE : player.aim;
+            player.attempts++;
+        }
+        // Turn towards the aim, then wait to see what it did
+        const int step = player.aim - player.pot;
+        player.pot += step > TURN_RATE ? TURN_RATE :
+                      step < -TURN_RATE ? -TURN_RATE : step;
+        Host_setAnalog(ADC_INPUT_A3, player.pot);
+        if (player.pot == player.aim)
+        {
+            player.busyUntil = hostNow + reaction;
+        }
+        break;
+    }
+    case SCREEN_BINARY:
+    {
+        const int value = HostPlayer_readHex();
+        const int key = HostPlayer_mistake() ? (value + 1) % 14 : value;
+        HostPlayer_key(hostNow, "0123456789ABCD"[key]);
+        player.busyUntil = hostNow + 2 * reaction;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/*!
+ * \brief This function watches the LEDs of the Reaction task
+ *
+ * The button is pressed a reaction time after the right LED comes on, or
+ * by mistake after another one does.
+ *
+ * \return None
+ */
+void HostPlayer_react(char lines[2][17])
+{
+    int wanted = 0;
+    while (wanted < 4 && "YBGR"[wanted] != lines[1][5])
+    {
+        wanted++;
+    }
+    if (wanted == 4)
+    {
+        // The LCD is still being written
+        return;
+    }
+    bool lit = false;
+    bool litWrong = false;
+    int led;
+    for (led = 0; led < 4; led++)
+    {
+        if (Host_readPin(GPIO_PORT_P3, ledPins[led]))
+        {
+            lit = true;
+            litWrong = litWrong || led != wanted;
+        }
+    }
+    const bool rising = lit && !player.ledOn;
+    player.ledOn = lit;
+    if (!rising || hostNow < player.busyUntil)
+    {
+        return;
+    }
+    if (!litWrong || HostPlayer_mistake())
+    {
+        const uint64_t time = hostNow + HostPlayer_reaction();
+        HostPlayer_switch(time, 5);
+        player.busyUntil = time + HOLD_MS * HOST_NS_PER_MS;
+    }
+}
+
+/*!
+ * \brief This function is what the player does every POLL_MS
+ *
+ * \return None
+ */
+void HostPlayer_poll(void *arg)
+{
+    char lines[2][17];
+    Host_readLCD(lines);
+    const PlayerScreen screen = HostPlayer_screen(lines);
+    // Game over is left to HostPlayer_finish, the task wasn't done
+    if (screen != player.screen && screen != SCREEN_OTHER
+            && screen != SCREEN_FIRED)
+    {
+        HostPlayer_enter(screen);
+    }
+    if (player.screen == SCREEN_REACTION)
+    {
+        // The LEDs are watched from the start, the reaction is the delay
+        HostPlayer_react(lines);
+    }
+    else if (hostNow >= player.busyUntil)
+    {
+        HostPlayer_act(lines);
+    }
+    Host_at(hostNow + POLL_MS * HOST_NS_PER_MS, HostPlayer_poll, NULL);
+}
+
+void HostPlayer_start(const char *config, int difficulty, uint64_t seed)
+{
+    player.on = true;
+    player.reactionMs = DEFAULT_REACTION_MS;
+    player.mistakePercent = DEFAULT_MISTAKE_PERCENT;
+    sscanf(config, "%u,%u", &player.reactionMs, &player.mistakePercent);
+    player.difficulty = difficulty;
+    // xorshift needs a state other than 0
+    player.random = seed * 0x9E3779B97F4A7C15ULL + 1;
+    player.screen = SCREEN_OTHER;
+    player.pot = player.aim = 8192;
+    player.temp = AMBIENT_TEMP;
+    Host_at(0, HostPlayer_poll, NULL);
+}
+
+void HostPlayer_finish(void)
+{
+    if (!player.on)
+    {
+        return;
+    }
+    char lines[2][17];
+    Host_readLCD(lines);
+    const PlayerScreen screen = HostPlayer_screen(lines);
+    if (screen == SCREEN_FIRED)
+    {
+        if (player.screen < NUM_OF_TASK_SCREENS)
+        {
+            HostPlayer_log("player stuck %s %llu", taskNames[player.screen],
+                           (unsigned long long) ((hostNow
+                                   - player.screenStart) / HOST_NS_PER_MS));
+        }
+        HostPlayer_log("player fired 0");
+    }
+    else if (screen == SCREEN_DONE)
+    {
+        // The last task ended when the salary came up
+        HostPlayer_enter(screen);
+        const char *salary = strchr(lines[1], '$');
+        HostPlayer_log("player done %lu",
+                       salary ? strtoul(salary + 1, NULL, 10) : 0);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * HostPrivate.h
+ *
+ * Description: Header file shared by the simulated peripherals. Each
+ *              peripheral keeps the virtual time of its next event. The core
+ *              runs the earliest event once the virtual time reaches it, and
+ *              takes pending interrupts between firmware calls.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef HOST_PRIVATE_H_
+#define HOST_PRIVATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdio.h>
+
+#include <Host.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+#define HOST_NEVER                                                  UINT64_MAX
+/* MCLK cycles charged for a DriverLib call and for a HAL register access */
+#define HOST_CALL_CYCLES                                            20
+#define HOST_ACCESS_CYCLES                                          2
+/* MCLK cycles from an interrupt request to its handler */
+#define HOST_ENTRY_CYCLES                                           12
+
+/* Peripherals with timed events, in the order ties are run */
+typedef enum _HostPeripheral
+{
+    HOST_SCRIPT, HOST_TIMER_A0, HOST_TIMER_A1, HOST_TIMER_A2, HOST_TIMER_A3,
+    HOST_TIMER32_1, HOST_TIMER32_2, HOST_SYSTICK, HOST_UART,
+    NUM_OF_HOST_PERIPHERALS
+} HostPeripheral;
+
+typedef bool (*HostCore_Level)(void);
+
+/* HostCore.c */
+extern uint64_t hostNow;
+extern void HostCore_call(uint32_t cycles);
+extern void HostCore_schedule(HostPeripheral peripheral, uint64_t time);
+extern void HostCore_setLevel(int interrupt, HostCore_Level level);
+extern void HostCore_request(int interrupt);
+extern void HostCore_update(int interrupt);
+extern uint64_t HostCore_ticksToTime(uint64_t ticks, uint32_t hz);
+extern uint64_t HostCore_timeToTicks(uint64_t time, uint32_t hz);
+extern void HostCore_log(FILE *stream, const char *text);
+
+/* HostClock.c */
+extern uint32_t HostClock_getMCLK(void);
+extern uint32_t HostClock_getSMCLK(void);
+extern uint32_t HostClock_getACLK(void);
+extern void HostClock_stop(bool stop);
+
+/* HostGPIO.c */
+extern void HostGPIO_init(void);
+
+/* HostTimerA.c */
+extern void HostTimerA_init(void);
+extern void HostTimerA_run(int timer, uint64_t time);
+extern void HostTimerA_clockChanged(void);
+extern void HostTimerA_watchChanging(void);
+extern void HostTimerA_watchChanged(void);
+
+/* HostTimer32.c */
+extern void HostTimer32_init(void);
+extern void HostTimer32_run(int timer, uint64_t time);
+extern void HostTimer32_clockChanged(void);
+
+/* HostSysTick.c */
+extern void HostSysTick_run(uint64_t time);
+extern void HostSysTick_clockChanged(void);
+
+/* HostADC.c */
+extern void HostADC_init(void);
+extern void HostADC_trigger(uint32_t source);
+extern bool HostADC_isTrigger(uint32_t source);
+extern void HostADC_resultRead(const volatile void *address);
+
+/* HostDMA.c */
+extern void HostDMA_init(void);
+extern void HostDMA_request(uint32_t mapping);
+extern bool HostDMA_isMapped(uint32_t mapping);
+
+/* HostUART.c */
+extern void HostUART_init(void);
+extern void HostUART_run(uint64_t time);
+extern void HostUART_written(const volatile void *address);
+
+/* HostLCD.c */
+extern void HostLCD_strobe(uint8_t port3, uint8_t port6);
+extern uint8_t HostLCD_driven(uint8_t *pins);
+extern bool HostLCD_changed(void);
+extern void HostLCD_print(FILE *stream);
+
+/* HostScript.c */
+extern void HostScript_run(uint64_t time);
+
+/* HostPlayer.c */
+extern void HostPlayer_start(const char *config, int difficulty,
+                             uint64_t seed);
+extern void HostPlayer_finish(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PRIVATE_H_ */
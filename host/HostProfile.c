@@ -0,0 +1,390 @@
+/*
+ * HostProfile.c
+ *
+ * Description: Turns a profile of the statistical profiler, see Profile.h,
+ *              into the samples of each function as CSV on stdout, most
+ *              samples first:
+ *
+ *                  capstone_profile -m <map file> <profile>
+ *                  capstone_profile -e <executable> <profile>
+ *
+ *              The profile is a copy of profile: the file capstone_telemetry
+ *              -p writes from what the board sends at the end of the game, a
+ *              binary dump of profile saved from the debugger, or the
+ *              HOST_PROFILE file of the simulated board. The functions come
+ *              from the .text lines of the map file the TI linker writes,
+ *              Debug/ece230capstoneCapBro.map, or from the symbols of an ELF
+ *              executable, the .out of the board or capstone_host. Samples at
+ *              an address no function covers are counted as "?", samples
+ *              taken while the CPU slept as "(asleep)".
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+/* Standard Includes */
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Host.h>
+#include <Profile.h>
+
+#define LINE_LENGTH                                                 512
+
+typedef struct _Symbol
+{
+    uint64_t start;
+    uint64_t end;           // Address after the last byte
+    char *name;
+    uint32_t samples;
+} Symbol;
+
+static Symbol *symbols = NULL;
+static size_t numSymbols = 0;
+static Profile loaded;
+
+/*!
+ * \brief This function adds a function to the symbols
+ *
+ * \param start is the address of the function
+ * \param size is the number of bytes of the function
+ * \param name is the name of the function, copied
+ *
+ * \return None
+ */
+void Profile_addSymbol(uint64_t start, uint64_t size, const char *name)
+{
+    static size_t capacity = 0;
+    if (numSymbols == capacity)
+    {
+        capacity = capacity ? 2 * capacity : 256;
+        if (!(symbols = realloc(symbols, capacity * sizeof(Symbol))))
+        {
+            perror("realloc");
+            exit(HOST_EXIT_USAGE);
+        }
+    }
+    symbols[numSymbols].start = start;
+    symbols[numSymbols].end = start + size;
+    symbols[numSymbols].name = strdup(name);
+    symbols[numSymbols].samples = 0;
+    numSymbols++;
+}
+
+/*!
+ * \brief This function reads the functions of a TI linker map file
+ *
+ * Each function is in its own input section, listed like
+ *      000008e4    00000078     delays.obj (.text:delayMicroSec)
+ * Sections of assembly files have no function name, so they are named after
+ * the object file.
+ *
+ * \return true if the file could be read
+ */
+bool Profile_loadMap(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        perror(path);
+        return false;
+    }
+    char line[LINE_LENGTH];
+    while (fgets(line, sizeof(line), file))
+    {
+        unsigned int start, size;
+        int skip = 0;
+        const char *section = strstr(line, "(.text");
+        if (!section || sscanf(line, " %x %x %n", &start, &size, &skip) != 2
+                || size == 0)
+        {
+            continue;
+        }
+        char name[LINE_LENGTH];
+        const char *close = strchr(section, ')');
+        const char *colon = strrchr(section, ':');
+        if (close && colon && colon < close)
+        {
+            // The last part of .text:decompress:lzss:__TI_decompress_lzss
+            snprintf(name, sizeof(name), "%.*s", (int) (close - colon - 1),
+                     colon + 1);
+        }
+        else
+        {
+            // The last word before the section, the object file
+            const char *end = section;
+            while (end > line + skip && end[-1] == ' ')
+            {
+                end--;
+            }
+            const char *begin = end;
+            while (begin > line + skip && begin[-1] != ' ')
+            {
+                begin--;
+            }
+            snprintf(name, sizeof(name), "%.*s", (int) (end - begin), begin);
+        }
+        Profile_addSymbol(start, size, name);
+    }
+    fclose(file);
+    return true;
+}
+
+/*!
+ * \brief This function reads the functions in the symbol table of an ELF
+ *          executable, 32 or 64-bit
+ *
+ * \return true if the file has a symbol table
+ */
+bool Profile_loadElf(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        perror(path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    const long length = ftell(file);
+    uint8_t *image = malloc(length);
+    rewind(file);
+    const bool read = image && fread(image, 1, length, file) == (size_t) length;
+    fclose(file);
+    if (!read || length < EI_NIDENT || memcmp(image, ELFMAG, SELFMAG) != 0)
+    {
+        fprintf(stderr, "%s: not an ELF file\n", path);
+        free(image);
+        return false;
+    }
+
+    const bool wide = image[EI_CLASS] == ELFCLASS64;
+    uint16_t machine, numSections;
+    uint64_t sections;
+    size_t sectionSize;
+    if (wide)
+    {
+        const Elf64_Ehdr *header = (const Elf64_Ehdr*) image;
+        machine = header->e_machine;
+        sections = header->e_shoff;
+        numSections = header->e_shnum;
+        sectionSize = sizeof(Elf64_Shdr);
+    }
+    else
+    {
+        const Elf32_Ehdr *header = (const Elf32_Ehdr*) image;
+        machine = header->e_machine;
+        sections = header->e_shoff;
+        numSections = header->e_shnum;
+        sectionSize = sizeof(Elf32_Shdr);
+    }
+
+    bool found = false;
+    int i;
+    for (i = 0; i < numSections; i++)
+    {
+        const uint8_t *section = image + sections + i * sectionSize;
+        uint64_t offset, size, entrySize, link;
+        if (wide)
+        {
+            const Elf64_Shdr *shdr = (const Elf64_Shdr*) section;
+            if (shdr->sh_type != SHT_SYMTAB)
+            {
+                continue;
+            }
+            offset = shdr->sh_offset;
+            size = shdr->sh_size;
+            entrySize = shdr->sh_entsize;
+            link = shdr->sh_link;
+        }
+        else
+        {
+            const Elf32_Shdr *shdr = (const Elf32_Shdr*) section;
+            if (shdr->sh_type != SHT_SYMTAB)
+            {
+                continue;
+            }
+            offset = shdr->sh_offset;
+            size = shdr->sh_size;
+            entrySize = shdr->sh_entsize;
+            link = shdr->sh_link;
+        }
+        const uint8_t *linked = image + sections + link * sectionSize;
+        const char *names = (const char*) image
+                + (wide ? ((const Elf64_Shdr*) linked)->sh_offset :
+                        ((const Elf32_Shdr*) linked)->sh_offset);
+        uint64_t at;
+        for (at = offset; at + entrySize <= offset + size; at += entrySize)
+        {
+            uint64_t value, symbolSize;
+            uint32_t name;
+            uint8_t info;
+            if (wide)
+            {
+                const Elf64_Sym *symbol = (const Elf64_Sym*) (image + at);
+                value = symbol->st_value;
+                symbolSize = symbol->st_size;
+                name = symbol->st_name;
+                info = symbol->st_info;
+            }
+            else
+            {
+                const Elf32_Sym *symbol = (const Elf32_Sym*) (image + at);
+                value = symbol->st_value;
+                symbolSize = symbol->st_size;
+                name = symbol->st_name;
+                info = symbol->st_info;
+            }
+            if (ELF32_ST_TYPE(info) == STT_FUNC && symbolSize > 0)
+            {
+                // Thumb function addresses have bit 0 set
+                Profile_addSymbol(
+                        machine == EM_ARM ? value & ~1ULL : value,
+                        symbolSize, names + name);
+            }
+        }
+        found = true;
+    }
+    free(image);
+    if (!found)
+    {
+        fprintf(stderr, "%s: no symbol table\n", path);
+    }
+    return found;
+}
+
+/*!
+ * \brief This function orders symbols by address
+ */
+int Profile_byAddress(const void *a, const void *b)
+{
+    const Symbol *first = a, *second = b;
+    return (first->start > second->start) - (first->start < second->start);
+}
+
+/*!
+ * \brief This function orders symbols by samples, most first
+ */
+int Profile_bySamples(const void *a, const void *b)
+{
+    const Symbol *first = a, *second = b;
+    return (first->samples < second->samples)
+            - (first->samples > second->samples);
+}
+
+/*!
+ * \brief This function finds the function an address is in
+ *
+ * \param pc is the address
+ *
+ * \return the symbol, or NULL if no function covers the address
+ */
+Symbol* Profile_find(uint64_t pc)
+{
+    size_t low = 0, high = numSymbols;
+    // The last symbol starting at or before pc
+    while (low < high)
+    {
+        const size_t middle = (low + high) / 2;
+        if (symbols[middle].start <= pc)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (low == 0 || pc >= symbols[low - 1].end)
+    {
+        return NULL;
+    }
+    return &symbols[low - 1];
+}
+
+int main(int argc, char *argv[])
+{
+    const char *map = NULL, *elf = NULL;
+    bool usage = false;
+    int option;
+    while ((option = getopt(argc, argv, "m:e:")) != -1)
+    {
+        switch (option)
+        {
+        case 'm':
+            map = optarg;
+            break;
+        case 'e':
+            elf = optarg;
+            break;
+        default:
+            usage = true;
+        }
+    }
+    if (usage || !map == !elf || optind + 1 != argc)
+    {
+        fprintf(stderr, "usage: %s -m <map file> | -e <executable> <profile>\n",
+                argv[0]);
+        return HOST_EXIT_USAGE;
+    }
+    if (map ? !Profile_loadMap(map) : !Profile_loadElf(elf))
+    {
+        return HOST_EXIT_USAGE;
+    }
+    qsort(symbols, numSymbols, sizeof(Symbol), Profile_byAddress);
+
+    FILE *file = fopen(argv[optind], "rb");
+    if (!file)
+    {
+        perror(argv[optind]);
+        return HOST_EXIT_USAGE;
+    }
+    const size_t got = fread(&loaded, 1, sizeof(loaded), file);
+    fclose(file);
+    if (got != sizeof(loaded) || loaded.magic != PROFILE_MAGIC)
+    {
+        fprintf(stderr, "%s: not a profile\n", argv[optind]);
+        return HOST_EXIT_USAGE;
+    }
+
+    uint64_t counted = 0, unknown = 0;
+    int i;
+    for (i = 0; i < PROFILE_SLOTS; i++)
+    {
+        const ProfileSlot *slot = &loaded.slots[i];
+        Symbol *symbol = Profile_find(slot->pc);
+        if (symbol)
+        {
+            symbol->samples += slot->count;
+        }
+        else
+        {
+            unknown += slot->count;
+        }
+        counted += slot->count;
+    }
+    Profile_addSymbol(0, 0, "(asleep)");
+    symbols[numSymbols - 1].samples = loaded.asleep;
+    counted += loaded.asleep;
+    qsort(symbols, numSymbols, sizeof(Symbol), Profile_bySamples);
+
+    printf("function,samples,percent\n");
+    size_t s;
+    for (s = 0; s < numSymbols && symbols[s].samples > 0; s++)
+    {
+        printf("%s,%u,%.2f\n", symbols[s].name, symbols[s].samples,
+               100.0 * symbols[s].samples / counted);
+    }
+    if (unknown > 0)
+    {
+        printf("?,%llu,%.2f\n", (unsigned long long) unknown,
+               100.0 * unknown / counted);
+    }
+    fprintf(stderr, "%u samples at %u Hz, %.1f s, %u dropped\n",
+            loaded.samples, loaded.hz,
+            loaded.hz ? (double) loaded.samples / loaded.hz : 0.0,
+            loaded.dropped);
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * HostScript.c
+ *
+ * Description: Helper file for the timed inputs of the simulated board. The
+ *              callbacks from Host_at are kept sorted by time and run like a
+ *              peripheral event. Host_loadScript turns a script file into
+ *              such callbacks.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_EVENTS                                                  256
+#define DEFAULT_HOLD_MS                                             100
+#define LINE_LENGTH                                                 128
+
+typedef struct _HostEvent
+{
+    uint64_t time;
+    Host_Callback callback;
+    void *arg;
+} HostEvent;
+
+typedef enum _HostActionType
+{
+    ACTION_PRESS_KEY, ACTION_RELEASE_KEY, ACTION_PRESS_SWITCH,
+    ACTION_RELEASE_SWITCH, ACTION_ANALOG
+} HostActionType;
+
+typedef struct _HostAction
+{
+    HostActionType type;
+    int target;             // Key character, switch pin or ADC input
+    uint16_t value;
+} HostAction;
+
+/* Sorted by time, events at the same time keep their order */
+static HostEvent events[MAX_EVENTS];
+static int numOfEvents = 0;
+
+void Host_at(uint64_t time, Host_Callback callback, void *arg)
+{
+    if (numOfEvents == MAX_EVENTS)
+    {
+        Host_halt("too many scheduled inputs", HOST_EXIT_USAGE);
+    }
+    if (time < hostNow)
+    {
+        time = hostNow;
+    }
+    int i = numOfEvents++;
+    while (i > 0 && events[i - 1].time > time)
+    {
+        events[i] = events[i - 1];
+        i--;
+    }
+    events[i].time = time;
+    events[i].callback = callback;
+    events[i].arg = arg;
+    HostCore_schedule(HOST_SCRIPT, events[0].time);
+}
+
+void HostScript_run(uint64_t time)
+{
+    int done = 0;
+    while (done < numOfEvents && events[done].time <= time)
+    {
+        done++;
+    }
+    // Copied out first, a callback may schedule more events
+    HostEvent due[MAX_EVENTS];
+    memcpy(due, events, done * sizeof(HostEvent));
+    numOfEvents -= done;
+    memmove(events, &events[done], numOfEvents * sizeof(HostEvent));
+    HostCore_schedule(HOST_SCRIPT, numOfEvents ? events[0].time : HOST_NEVER);
+    int i;
+    for (i = 0; i < done; i++)
+    {
+        due[i].callback(due[i].arg);
+    }
+}
+
+/*!
+ * \brief This function runs an action of a script
+ *
+ * \param arg is the HostAction
+ *
+ * \return None
+ */
+void HostScript_act(void *arg)
+{
+    const HostAction *action = arg;
+    switch (action->type)
+    {
+    case ACTION_PRESS_KEY:
+    case ACTION_RELEASE_KEY:
+        Host_setKey(action->target, action->type == ACTION_PRESS_KEY);
+        break;
+    case ACTION_PRESS_SWITCH:
+    case ACTION_RELEASE_SWITCH:
+        Host_setSwitch(action->target, action->type == ACTION_PRESS_SWITCH);
+        break;
+    case ACTION_ANALOG:
+        Host_setAnalog(action->target, action->value);
+        break;
+    }
+}
+
+/*!
+ * \brief This function schedules an action of a script
+ *
+ * The actions are never freed, a script runs once per process.
+ *
+ * \return None
+ */
+void HostScript_add(uint64_t time, HostActionType type, int target,
+                    uint16_t value)
+{
+    HostAction *action = malloc(sizeof(HostAction));
+    action->type = type;
+    action->target = target;
+    action->value = value;
+    Host_at(time, HostScript_act, action);
+}
+
+/*!
+ * \brief This function reads the optional hold time of a press
+ *
+ * \param text is the rest of the line
+ *
+ * \return the hold time in nanoseconds, 0 if the text isn't a hold time
+ */
+uint64_t HostScript_hold(const char *text)
+{
+    unsigned long ms = DEFAULT_HOLD_MS;
+    char extra;
+    if (sscanf(text, " %lu %c", &ms, &extra) == 2 || ms == 0)
+    {
+        return 0;
+    }
+    return ms * HOST_NS_PER_MS;
+}
+
+bool Host_loadScript(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        perror(path);
+        return false;
+    }
+    char line[LINE_LENGTH];
+    int number = 0;
+    uint64_t last = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file))
+    {
+        number++;
+        char *comment = strchr(line, '#');
+        if (comment)
+        {
+            *comment = '\0';
+        }
+        char when[24], command[16], target[8];
+        int used = 0;
+        const int fields = sscanf(line, " %23s %15s %7s %n", when, command,
+                                  target, &used);
+        if (fields <= 0)
+        {
+            continue;
+        }
+        ok = fields == 3;
+        char *end;
+        uint64_t time = strtoull(when + (when[0] == '+'), &end, 10)
+                * HOST_NS_PER_MS;
+        ok = ok && *end == '\0';
+        if (when[0] == '+')
+        {
+            time += last;
+        }
+        last = time;
+        const char *rest = line + used;
+
+        if (ok && strcmp(command, "key") == 0)
+        {
+            const uint64_t hold = HostScript_hold(rest);
+            // Releasing a key that isn't down checks it exists
+            ok = target[1] == '\0' && hold && Host_setKey(target[0], false);
+            if (ok)
+            {
+                HostScript_add(time, ACTION_PRESS_KEY, target[0], 0);
+                HostScript_add(time + hold, ACTION_RELEASE_KEY, target[0], 0);
+            }
+        }
+        else if (ok && strcmp(command, "switch") == 0)
+        {
+            const uint64_t hold = HostScript_hold(rest);
+            const int pin = atoi(target);
+            ok = (pin == 1 || pin == 4 || pin == 5) && hold;
+            if (ok)
+            {
+                HostScript_add(time, ACTION_PRESS_SWITCH, pin, 0);
+                HostScript_add(time + hold, ACTION_RELEASE_SWITCH, pin, 0);
+            }
+        }
+        else if (ok && strcmp(command, "analog") == 0)
+        {
+            unsigned int value;
+            const int input = target[0] == 'A' ? atoi(target + 1) : -1;
+            ok = input >= ADC_INPUT_A3 && input <= ADC_INPUT_A5
+                    && sscanf(rest, "%u", &value) == 1 && value <= 0x3FFF;
+            if (ok)
+            {
+                HostScript_add(time, ACTION_ANALOG, input, value);
+            }
+        }
+        else
+        {
+            ok = false;
+        }
+    }
+    fclose(file);
+    if (!ok)
+    {
+        fprintf(stderr, "%s:%d: not understood\n", path, number);
+    }
+    return ok;
+}
@@ -0,0 +1,430 @@
+/*
+ * HostSweep.c
+ *
+ * Description: Runs batches of simulated games with the simulated player
+ *              and reports, for each difficulty, how many games were
+ *              completed, the salaries, the active-mode residency (see
+ *              Power.h) and how long each task took. The firmware keeps its
+ *              state in globals, so every game is its own capstone_host
+ *              process. A pool of threads keeps one game running per core.
+ *
+ *                  capstone_sweep [-n games] [-j threads] [-p player]
+ *                                 [-d difficulty] [-s seed] [capstone_host]
+ *
+ *              -n is the number of games per difficulty, default 1000
+ *              -j is the number of games run at once, default one per core
+ *              -p is HOST_PLAYER, "<reaction ms>,<mistake %>", default 300,5
+ *              -d runs a single difficulty, 0 - 2, instead of all three
+ *              -s is the HOST_SEED of the first game, the others follow it
+ *
+ *              Times are virtual and come from the simulated board, not
+ *              from the MSP432.
+ *
+ *  Created on: Mar 7, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+/* Standard Includes */
+#include <limits.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Host.h>
+
+#define NUM_OF_DIFFICULTIES                                         3
+#define NUM_OF_TASKS                                                7
+#define TASK_NOT_DONE                                               -1
+#define DEFAULT_GAMES                                               1000
+#define DEFAULT_PLAYER                                              "300,5"
+#define LINE_LENGTH                                                 128
+
+typedef struct _SweepGame
+{
+    int difficulty;
+    unsigned long seed;
+    int status;             // Exit status of capstone_host, see HOST_EXIT_*
+    unsigned long salary;
+    long taskMs[NUM_OF_TASKS];
+    int stuck;              // Task the player was fired on, or -1
+    long active;            // Active-mode residency in 0.1 %, or -1
+} SweepGame;
+
+/* In the order of Tasks, like the player logs them */
+static const char *const taskNames[NUM_OF_TASKS] = {
+        "password", "lights", "temp", "direction", "power", "reaction",
+        "binary" };
+static const char *const difficultyNames[NUM_OF_DIFFICULTIES] = {
+        "Easy", "Medium", "Hard" };
+
+static char hostPath[PATH_MAX];
+static const char *playerConfig = DEFAULT_PLAYER;
+static SweepGame *games;
+static int numOfGames;
+static int nextGame = 0;
+static pthread_mutex_t nextLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+ * \brief This function looks up a task by the name the player logs
+ *
+ * \return the task, -1 if there's no such task
+ */
+int Sweep_task(const char *name)
+{
+    int task;
+    for (task = 0; task < NUM_OF_TASKS; task++)
+    {
+        if (strcmp(name, taskNames[task]) == 0)
+        {
+            return task;
+        }
+    }
+    return -1;
+}
+
+/*!
+ * \brief This function reads a line the player logged
+ *
+ * The lines look like "[  12.345678] player task power 1000", or like
+ * "[  15.944231] power active 351 wakeups 1490" for the residency.
+ *
+ * \return None
+ */
+void Sweep_parse(SweepGame *game, const char *line)
+{
+    const char *text = strstr(line, "] power active ");
+    if (text)
+    {
+        sscanf(text + 15, "%ld", &game->active);
+        return;
+    }
+    text = strstr(line, "] player ");
+    if (!text)
+    {
+        return;
+    }
+    char what[16], name[16];
+    unsigned long value;
+    if (sscanf(text + 9, "%15s %15s %lu", what, name, &value) == 3)
+    {
+        const int task = Sweep_task(name);
+        if (task >= 0 && strcmp(what, "task") == 0)
+        {
+            game->taskMs[task] = value;
+        }
+        else if (task >= 0 && strcmp(what, "stuck") == 0)
+        {
+            game->stuck = task;
+        }
+    }
+    else if (sscanf(text + 9, "done %lu", &value) == 1)
+    {
+        game->salary = value;
+    }
+}
+
+/*!
+ * \brief This function plays one game in its own process
+ *
+ * \return None
+ */
+void Sweep_play(SweepGame *game)
+{
+    int task;
+    for (task = 0; task < NUM_OF_TASKS; task++)
+    {
+        game->taskMs[task] = TASK_NOT_DONE;
+    }
+    game->stuck = -1;
+    game->active = -1;
+    game->status = -1;
+
+    char seed[32], difficulty[32], player[64];
+    snprintf(seed, sizeof(seed), "HOST_SEED=%lu", game->seed);
+    snprintf(difficulty, sizeof(difficulty), "HOST_DIFFICULTY=%d",
+             game->difficulty);
+    snprintf(player, sizeof(player), "HOST_PLAYER=%s", playerConfig);
+    char *const argv[] = { hostPath, NULL };
+    char *const envp[] = { seed, difficulty, player, NULL };
+
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        perror("pipe");
+        return;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+    pid_t pid;
+    const int error = posix_spawn(&pid, hostPath, &actions, NULL, argv, envp);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (error)
+    {
+        fprintf(stderr, "%s: %s\n", hostPath, strerror(error));
+        close(fds[0]);
+        return;
+    }
+
+    FILE *output = fdopen(fds[0], "r");
+    char line[LINE_LENGTH];
+    while (fgets(line, sizeof(line), output))
+    {
+        Sweep_parse(game, line);
+    }
+    fclose(output);
+    int status;
+    if (waitpid(pid, &status, 0) == pid && WIFEXITED(status))
+    {
+        game->status = WEXITSTATUS(status);
+    }
+}
+
+/*!
+ * \brief This function is a thread of the pool, it plays games until none
+ *          are left
+ *
+ * \return NULL
+ */
+void* Sweep_worker(void *arg)
+{
+    while (1)
+    {
+        pthread_mutex_lock(&nextLock);
+        const int index = nextGame++;
+        pthread_mutex_unlock(&nextLock);
+        if (index >= numOfGames)
+        {
+            return NULL;
+        }
+        Sweep_play(&games[index]);
+    }
+}
+
+int Sweep_compare(const void *a, const void *b)
+{
+    const long x = *(const long*) a;
+    const long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+/*!
+ * \brief This function prints the mean and percentiles of some values
+ *
+ * The line isn't ended, so more columns can follow.
+ *
+ * \param values are sorted in place
+ *
+ * \return None
+ */
+void Sweep_printStats(long *values, int count)
+{
+    if (count == 0)
+    {
+        printf("%8s %8s %8s %8s %8s", "-", "-", "-", "-", "-");
+        return;
+    }
+    qsort(values, count, sizeof(long), Sweep_compare);
+    double sum = 0;
+    int i;
+    for (i = 0; i < count; i++)
+    {
+        sum += values[i];
+    }
+    printf("%8.0f %8ld %8ld %8ld %8ld", sum / count,
+           values[count / 10], values[count / 2], values[count * 9 / 10],
+           values[count - 1]);
+}
+
+/*!
+ * \brief This function prints the report of one difficulty
+ *
+ * \return None
+ */
+void Sweep_report(int difficulty)
+{
+    long *values = malloc(numOfGames * sizeof(long));
+    int played = 0, done = 0, fired = 0, failed = 0;
+    int stuck[NUM_OF_TASKS] = { 0 };
+    int i;
+    for (i = 0; i < numOfGames; i++)
+    {
+        const SweepGame *game = &games[i];
+        if (game->difficulty != difficulty)
+        {
+            continue;
+        }
+        played++;
+        if (game->status == HOST_EXIT_DONE)
+        {
+            values[done++] = game->salary;
+        }
+        else if (game->status == HOST_EXIT_ABORT)
+        {
+            fired++;
+            if (game->stuck >= 0)
+            {
+                stuck[game->stuck]++;
+            }
+        }
+        else
+        {
+            failed++;
+        }
+    }
+    if (played == 0)
+    {
+        free(values);
+        return;
+    }
+
+    printf("\n%s: %d games, %.1f%% completed, %d fired, %d failed\n",
+           difficultyNames[difficulty], played, 100.0 * done / played, fired,
+           failed);
+    printf("%-12s %6s %8s %8s %8s %8s %8s\n", "", "games", "mean", "p10",
+           "p50", "p90", "max");
+    printf("%-12s %6d ", "salary $", done);
+    Sweep_printStats(values, done);
+    printf("\n");
+    int measured = 0;
+    for (i = 0; i < numOfGames; i++)
+    {
+        if (games[i].difficulty == difficulty && games[i].active >= 0)
+        {
+            values[measured++] = games[i].active;
+        }
+    }
+    printf("%-12s %6d ", "active 0.1%", measured);
+    Sweep_printStats(values, measured);
+    printf("\n");
+
+    printf("%-12s %6s %8s %8s %8s %8s %8s %6s\n", "task ms", "done", "mean",
+           "p10", "p50", "p90", "max", "fired");
+    int task;
+    for (task = 0; task < NUM_OF_TASKS; task++)
+    {
+        int count = 0;
+        for (i = 0; i < numOfGames; i++)
+        {
+            if (games[i].difficulty == difficulty
+                    && games[i].taskMs[task] != TASK_NOT_DONE)
+            {
+                values[count++] = games[i].taskMs[task];
+            }
+        }
+        printf("%-12s %6d ", taskNames[task], count);
+        Sweep_printStats(values, count);
+        printf(" %6d\n", stuck[task]);
+    }
+    free(values);
+}
+
+/*!
+ * \brief This function finds capstone_host next to this program
+ *
+ * \return None
+ */
+void Sweep_findHost(void)
+{
+    const ssize_t length = readlink("/proc/self/exe", hostPath,
+                                    sizeof(hostPath) - 1);
+    hostPath[length > 0 ? length : 0] = '\0';
+    char *slash = strrchr(hostPath, '/');
+    const size_t at = slash ? slash + 1 - hostPath : 0;
+    snprintf(hostPath + at, sizeof(hostPath) - at, "capstone_host");
+}
+
+int main(int argc, char *argv[])
+{
+    int gamesPerDifficulty = DEFAULT_GAMES;
+    int threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int only = -1;
+    unsigned long seed = 1;
+    int option;
+    while ((option = getopt(argc, argv, "n:j:p:d:s:")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            gamesPerDifficulty = atoi(optarg);
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            break;
+        case 'p':
+            playerConfig = optarg;
+            break;
+        case 'd':
+            only = atoi(optarg);
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n games] [-j threads] [-p player] "
+                    "[-d difficulty] [-s seed] [capstone_host]\n",
+                    argv[0]);
+            return HOST_EXIT_USAGE;
+        }
+    }
+    if (optind < argc)
+    {
+        snprintf(hostPath, sizeof(hostPath), "%s", argv[optind]);
+    }
+    else
+    {
+        Sweep_findHost();
+    }
+    if (gamesPerDifficulty <= 0 || threads <= 0 || only >= NUM_OF_DIFFICULTIES)
+    {
+        fprintf(stderr, "%s: bad option\n", argv[0]);
+        return HOST_EXIT_USAGE;
+    }
+
+    // Every difficulty plays the same seeds
+    const int difficulties = only < 0 ? NUM_OF_DIFFICULTIES : 1;
+    numOfGames = gamesPerDifficulty * difficulties;
+    games = calloc(numOfGames, sizeof(SweepGame));
+    int i;
+    for (i = 0; i < numOfGames; i++)
+    {
+        games[i].difficulty = only < 0 ? i / gamesPerDifficulty : only;
+        games[i].seed = seed + i % gamesPerDifficulty;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_t *pool = malloc(threads * sizeof(pthread_t));
+    for (i = 0; i < threads; i++)
+    {
+        pthread_create(&pool[i], NULL, Sweep_worker, NULL);
+    }
+    for (i = 0; i < threads; i++)
+    {
+        pthread_join(pool[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const double seconds = (end.tv_sec - start.tv_sec)
+            + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("%d games with player %s on %d threads in %.2f s, %.0f games/s\n",
+           numOfGames, playerConfig, threads, seconds, numOfGames / seconds);
+    int difficulty;
+    for (difficulty = 0; difficulty < NUM_OF_DIFFICULTIES; difficulty++)
+    {
+        Sweep_report(difficulty);
+    }
+    free(pool);
+    free(games);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * HostSysTick.c
+ *
+ * Description: Helper file for the simulated SysTick. It counts MCLK down
+ *              from LOAD to 0. At 0 it sets COUNTFLAG, pends the SysTick
+ *              exception when TICKINT is set and reloads on the next tick.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define SYSTICK_MAX                                                 0x00FFFFFF
+
+typedef struct _HostSysTick
+{
+    uint32_t load;
+    bool enabled;
+    bool tickInt;
+    bool countFlag;
+    uint32_t value;         // Count while disabled
+    uint32_t clockHz;       // MCLK when anchored
+    uint64_t anchor;        // Virtual time the count was last set
+    uint64_t nextZero;      // Ticks from the anchor to the next 0
+} HostSysTick;
+
+static HostSysTick sysTick;
+
+/*!
+ * \brief This function gets the count of SysTick now
+ *
+ * \return the value of SYST_CVR
+ */
+uint32_t HostSysTick_value(void)
+{
+    if (!sysTick.enabled)
+    {
+        return sysTick.value;
+    }
+    const uint64_t ticks = HostCore_timeToTicks(hostNow - sysTick.anchor,
+                                                sysTick.clockHz);
+    return ticks >= sysTick.nextZero ? 0 : sysTick.nextZero - ticks;
+}
+
+void HostSysTick_schedule(void)
+{
+    uint64_t time = HOST_NEVER;
+    if (sysTick.enabled)
+    {
+        time = sysTick.anchor
+                + HostCore_ticksToTime(sysTick.nextZero, sysTick.clockHz);
+    }
+    HostCore_schedule(HOST_SYSTICK, time);
+}
+
+/*!
+ * \brief This function restarts the count of SysTick from a value now
+ *
+ * A count of 0 reloads LOAD on the next tick.
+ *
+ * \param value is the count to continue from
+ *
+ * \return None
+ */
+void HostSysTick_anchor(uint32_t value)
+{
+    sysTick.value = value;
+    sysTick.clockHz = HostClock_getMCLK();
+    sysTick.anchor = hostNow;
+    sysTick.nextZero = value ? value : sysTick.load + 1;
+    HostSysTick_schedule();
+}
+
+void HostSysTick_run(uint64_t time)
+{
+    if (!sysTick.enabled)
+    {
+        return;
+    }
+    sysTick.countFlag = true;
+    sysTick.nextZero += sysTick.load + 1;
+    HostSysTick_schedule();
+    if (sysTick.tickInt)
+    {
+        HostCore_request(FAULT_SYSTICK);
+    }
+}
+
+void HostSysTick_clockChanged(void)
+{
+    if (sysTick.enabled)
+    {
+        HostSysTick_anchor(HostSysTick_value());
+    }
+}
+
+void HAL_loadSysTick(uint32_t ticks)
+{
+    HostCore_call(HOST_ACCESS_CYCLES * 2);
+    sysTick.load = (ticks - 1) & SYSTICK_MAX;
+    // Writing VAL clears it and COUNTFLAG
+    sysTick.countFlag = false;
+    if (sysTick.enabled)
+    {
+        HostSysTick_anchor(0);
+    }
+    else
+    {
+        sysTick.value = 0;
+    }
+}
+
+bool HAL_isSysTickExpired(void)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    const bool expired = sysTick.countFlag;
+    sysTick.countFlag = false;
+    return expired;
+}
+
+void SysTick_enableModule(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    if (!sysTick.enabled)
+    {
+        sysTick.enabled = true;
+        HostSysTick_anchor(sysTick.value);
+    }
+}
+
+void SysTick_disableModule(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    sysTick.value = HostSysTick_value();
+    sysTick.enabled = false;
+    HostSysTick_schedule();
+}
+
+void SysTick_enableInterrupt(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    sysTick.tickInt = true;
+}
+
+void SysTick_disableInterrupt(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    sysTick.tickInt = false;
+}
+
+void SysTick_setPeriod(uint32_t period)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    sysTick.load = (period - 1) & SYSTICK_MAX;
+}
+
+uint32_t SysTick_getPeriod(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return sysTick.load + 1;
+}
+
+uint32_t SysTick_getValue(void)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return HostSysTick_value();
+}
@@ -0,0 +1,194 @@
+/*
+ * HostTelemetry.c
+ *
+ * Description: Decodes the records of the telemetry channel, see Telemetry.h,
+ *              into CSV on stdout. The input is a file written by the
+ *              simulated board through HOST_UART, or the backchannel UART of
+ *              the LaunchPad, which is set up for 115200 8N1:
+ *
+ *                  capstone_telemetry [-t recording] [-p profile]
+ *                                     [file or serial device]
+ *
+ *              stdin is read when no input is given. With -t the bytes of
+ *              TELEMETRY_TRACE records are also written to the recording
+ *              file, for host/HostTrace.c, and with -p the bytes of
+ *              TELEMETRY_PROFILE records to the profile file, for
+ *              host/HostProfile.c. Bytes that don't make a valid record are
+ *              skipped until the next TELEMETRY_SYNC. Gaps in the sequence
+ *              numbers are records dropped by the board or lost on the way,
+ *              they are counted on stderr at the end.
+ *
+ *  Created on: Mar 9, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+/* Standard Includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <Host.h>
+#include <Telemetry.h>
+#include <Timebase.h>
+
+static const char *const typeNames[NUM_OF_TELEMETRY_TYPES] = {
+        "difficulty", "task_start", "task_done", "penalty", "pot", "therm",
+        "photo", "salary", "trace", "profile", "reaction" };
+
+/*!
+ * \brief This function sets a serial device up for the telemetry channel
+ *
+ * \param fd is the open device
+ *
+ * \return true if it worked
+ */
+bool Telemetry_setupSerial(int fd)
+{
+    struct termios tty;
+    if (tcgetattr(fd, &tty) != 0)
+    {
+        return false;
+    }
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, B115200);
+    cfsetospeed(&tty, B115200);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cflag &= ~(CSTOPB | PARENB);
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+/*!
+ * \brief This function checks whether bytes are a valid record
+ *
+ * \param record is TELEMETRY_RECORD_SIZE bytes starting at a TELEMETRY_SYNC
+ *
+ * \return true if the checksum and type are right
+ */
+bool Telemetry_isValid(const uint8_t *record)
+{
+    uint8_t check = 0;
+    int i;
+    for (i = 0; i < TELEMETRY_RECORD_SIZE; i++)
+    {
+        check ^= record[i];
+    }
+    return check == 0 && record[1] < NUM_OF_TELEMETRY_TYPES;
+}
+
+/*!
+ * \brief This function prints a record as a line of CSV
+ *
+ * \return None
+ */
+void Telemetry_print(const uint8_t *record)
+{
+    const uint32_t ticks = record[3] | record[4] << 8 | record[5] << 16
+            | (uint32_t) record[6] << 24;
+    const int32_t value = (int32_t) (record[7] | record[8] << 8
+            | record[9] << 16 | (uint32_t) record[10] << 24);
+    printf("%u,%u,%.3f,%s,%d\n", record[2], ticks,
+           ticks * 1000.0 / TIMEBASE_HZ, typeNames[record[1]], value);
+}
+
+int main(int argc, char *argv[])
+{
+    int fd = STDIN_FILENO;
+    FILE *recording = NULL;
+    FILE *profile = NULL;
+    bool usage = false;
+    int option;
+    while ((option = getopt(argc, argv, "t:p:")) != -1)
+    {
+        switch (option)
+        {
+        case 't':
+            if (!(recording = fopen(optarg, "wb")))
+            {
+                perror(optarg);
+                return HOST_EXIT_USAGE;
+            }
+            break;
+        case 'p':
+            if (!(profile = fopen(optarg, "wb")))
+            {
+                perror(optarg);
+                return HOST_EXIT_USAGE;
+            }
+            break;
+        default:
+            usage = true;
+        }
+    }
+    if (usage || optind + 1 < argc)
+    {
+        fprintf(stderr, "usage: %s [-t recording] [-p profile] "
+                "[file or serial device]\n", argv[0]);
+        return HOST_EXIT_USAGE;
+    }
+    if (optind < argc && (fd = open(argv[optind], O_RDONLY | O_NOCTTY)) < 0)
+    {
+        perror(argv[optind]);
+        return HOST_EXIT_USAGE;
+    }
+    if (isatty(fd) && !Telemetry_setupSerial(fd))
+    {
+        perror("termios");
+        return HOST_EXIT_USAGE;
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    printf("sequence,ticks,ms,record,value\n");
+    uint8_t buffer[4096];
+    size_t length = 0;
+    unsigned long records = 0, lost = 0, skipped = 0;
+    int lastSequence = -1;
+    ssize_t got;
+    while ((got = read(fd, buffer + length, sizeof(buffer) - length)) > 0)
+    {
+        length += got;
+        size_t at = 0;
+        while (length - at >= TELEMETRY_RECORD_SIZE)
+        {
+            const uint8_t *record = buffer + at;
+            if (record[0] != TELEMETRY_SYNC || !Telemetry_isValid(record))
+            {
+                at++;
+                skipped++;
+                continue;
+            }
+            if (lastSequence >= 0)
+            {
+                lost += (uint8_t) (record[2] - lastSequence - 1);
+            }
+            lastSequence = record[2];
+            Telemetry_print(record);
+            if (recording && record[1] == TELEMETRY_TRACE)
+            {
+                fwrite(record + 7, 1, 4, recording);
+            }
+            if (profile && record[1] == TELEMETRY_PROFILE)
+            {
+                fwrite(record + 7, 1, 4, profile);
+            }
+            records++;
+            at += TELEMETRY_RECORD_SIZE;
+        }
+        memmove(buffer, buffer + at, length - at);
+        length -= at;
+    }
+    fprintf(stderr, "%lu records, %lu lost, %lu bytes skipped\n", records,
+            lost, skipped + length);
+    if (recording)
+    {
+        fclose(recording);
+    }
+    if (profile)
+    {
+        fclose(profile);
+    }
+    return 0;
+}
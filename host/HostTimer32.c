@@ -0,0 +1,229 @@
+/*
+ * HostTimer32.c
+ *
+ * Description: Helper file for the simulated Timer32_0 and Timer32_1. Each
+ *              timer counts MCLK down to 0 and raises its interrupt there.
+ *              Then it stops in one-shot mode, reloads LOAD in periodic mode
+ *              or wraps to its maximum in free-running mode.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define NUM_OF_TIMERS                                               2
+#define TIMER_INDEX(base)                   (((base) - TIMER32_0_BASE) >> 5)
+
+typedef struct _HostTimer32
+{
+    uint32_t load;
+    uint32_t max;           // 0xFFFF or 0xFFFFFFFF
+    uint32_t shift;         // log2 of the prescaler
+    bool periodic;
+    bool oneShot;
+    bool running;
+    bool ie;
+    bool ris;
+    uint32_t value;         // Count while halted
+    uint32_t clockHz;       // MCLK when anchored
+    uint64_t anchor;        // Virtual time the count was last set
+    uint64_t nextZero;      // Ticks from the anchor to the next 0
+} HostTimer32;
+
+static HostTimer32 timers[NUM_OF_TIMERS];
+
+/*!
+ * \brief This function gets the ticks a timer counted since its anchor
+ *
+ * \return the number of prescaled ticks
+ */
+uint64_t HostTimer32_ticks(const HostTimer32 *timer, uint64_t time)
+{
+    return HostCore_timeToTicks(time - timer->anchor, timer->clockHz)
+            >> timer->shift;
+}
+
+/*!
+ * \brief This function gets the count of a timer now
+ *
+ * \return the value of TxVALUE
+ */
+uint32_t HostTimer32_value(const HostTimer32 *timer)
+{
+    if (!timer->running)
+    {
+        return timer->value;
+    }
+    const uint64_t ticks = HostTimer32_ticks(timer, hostNow);
+    return ticks >= timer->nextZero ? 0 : timer->nextZero - ticks;
+}
+
+/*!
+ * \brief This function schedules the next 0 of a timer
+ *
+ * \return None
+ */
+void HostTimer32_schedule(int index)
+{
+    const HostTimer32 *timer = &timers[index];
+    uint64_t time = HOST_NEVER;
+    if (timer->running)
+    {
+        time = timer->anchor
+                + HostCore_ticksToTime(timer->nextZero << timer->shift,
+                                       timer->clockHz);
+    }
+    HostCore_schedule(HOST_TIMER32_1 + index, time);
+}
+
+/*!
+ * \brief This function restarts a timer's count from a value now
+ *
+ * \param value is the count to continue from
+ *
+ * \return None
+ */
+void HostTimer32_anchor(int index, uint32_t value)
+{
+    HostTimer32 *timer = &timers[index];
+    timer->value = value & timer->max;
+    timer->clockHz = HostClock_getMCLK();
+    timer->anchor = hostNow;
+    timer->nextZero = timer->value;
+    HostTimer32_schedule(index);
+}
+
+/*!
+ * \brief This function gets a timer and charges the call
+ *
+ * \return the timer
+ */
+HostTimer32* HostTimer32_get(uint32_t base)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return &timers[TIMER_INDEX(base)];
+}
+
+bool HostTimer32_level1(void)
+{
+    return timers[0].ie && timers[0].ris;
+}
+
+bool HostTimer32_level2(void)
+{
+    return timers[1].ie && timers[1].ris;
+}
+
+void HostTimer32_init(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        // Reset state: 32-bit periodic, interrupt enabled, LOAD of 0
+        timers[index].max = 0xFFFFFFFF;
+        timers[index].periodic = true;
+        timers[index].ie = true;
+    }
+    HostCore_setLevel(INT_T32_INT1, HostTimer32_level1);
+    HostCore_setLevel(INT_T32_INT2, HostTimer32_level2);
+}
+
+void HostTimer32_run(int index, uint64_t time)
+{
+    HostTimer32 *timer = &timers[index];
+    if (!timer->running)
+    {
+        return;
+    }
+    timer->ris = true;
+    if (timer->oneShot)
+    {
+        timer->running = false;
+        timer->value = 0;
+    }
+    else
+    {
+        // The count is reloaded on the tick after 0
+        timer->nextZero += 1 + (timer->periodic ? timer->load : timer->max);
+    }
+    HostTimer32_schedule(index);
+    HostCore_update(INT_T32_INT1 + index);
+}
+
+void HostTimer32_clockChanged(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        if (timers[index].running)
+        {
+            HostTimer32_anchor(index, HostTimer32_value(&timers[index]));
+        }
+    }
+}
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler,
+                        uint32_t resolution, uint32_t mode)
+{
+    HostTimer32 *state = HostTimer32_get(timer);
+    state->shift = (preScaler >> 2) * 4;
+    state->max = resolution == TIMER32_32BIT ? 0xFFFFFFFF : 0xFFFF;
+    state->periodic = mode == TIMER32_PERIODIC_MODE;
+    state->running = false;
+    state->value &= state->max;
+    HostTimer32_schedule(TIMER_INDEX(timer));
+}
+
+void Timer32_setCount(uint32_t timer, uint32_t count)
+{
+    HostTimer32 *state = HostTimer32_get(timer);
+    // Writing LOAD also loads the count
+    state->load = count & state->max;
+    HostTimer32_anchor(TIMER_INDEX(timer), count);
+}
+
+uint32_t Timer32_getValue(uint32_t timer)
+{
+    return HostTimer32_value(HostTimer32_get(timer));
+}
+
+void Timer32_startTimer(uint32_t timer, bool oneShot)
+{
+    HostTimer32 *state = HostTimer32_get(timer);
+    state->oneShot = oneShot;
+    if (!state->running)
+    {
+        state->running = true;
+        HostTimer32_anchor(TIMER_INDEX(timer), state->value);
+    }
+}
+
+void Timer32_haltTimer(uint32_t timer)
+{
+    HostTimer32 *state = HostTimer32_get(timer);
+    state->value = HostTimer32_value(state);
+    state->running = false;
+    HostTimer32_schedule(TIMER_INDEX(timer));
+}
+
+void Timer32_enableInterrupt(uint32_t timer)
+{
+    HostTimer32_get(timer)->ie = true;
+    HostCore_update(INT_T32_INT1 + TIMER_INDEX(timer));
+}
+
+void Timer32_disableInterrupt(uint32_t timer)
+{
+    HostTimer32_get(timer)->ie = false;
+}
+
+void Timer32_clearInterruptFlag(uint32_t timer)
+{
+    HostTimer32_get(timer)->ris = false;
+}
+
+uint32_t Timer32_getInterruptStatus(uint32_t timer)
+{
+    const HostTimer32 *state = HostTimer32_get(timer);
+    return state->ie && state->ris;
+}
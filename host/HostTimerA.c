@@ -0,0 +1,746 @@
+/*
+ * HostTimerA.c
+ *
+ * Description: Helper file for the simulated TimerA0 - TimerA3. A timer isn't
+ *              stepped every tick. It jumps straight to the next count where
+ *              something happens: a compare match, CCR0 or the return to 0.
+ *              Output units follow their output mode, and the outputs wired
+ *              to the ADC14 trigger a conversion on their rising edge. A
+ *              timer nothing watches, like the buzzer, gets no events at all
+ *              and skips whole cycles when it is read.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+#define NUM_OF_TIMERS                                               4
+#define NUM_OF_CCRS                                                 5
+#define TIMER_INDEX(base)                   (((base) - TIMER_A0_BASE) >> 10)
+#define CCR_INDEX(reg)                                      (((reg) >> 1) - 1)
+#define TAIV_TAIFG                                                  0x0E
+#define TIMER_A1_CCR0_TRIGGER                                       2
+
+typedef struct _HostTimerA
+{
+    uint_fast16_t source;
+    uint32_t divider;
+    uint32_t clockHz;       // Source frequency when anchored
+    uint_fast16_t mode;
+    uint16_t count;
+    bool down;              // Counting down in up/down mode
+    bool taie;
+    bool taifg;
+    uint16_t ccr[NUM_OF_CCRS];
+    bool capture[NUM_OF_CCRS];
+    bool ccie[NUM_OF_CCRS];
+    bool ccifg[NUM_OF_CCRS];
+    uint8_t outputMode[NUM_OF_CCRS];
+    bool out[NUM_OF_CCRS];
+    uint64_t anchor;        // Virtual time of tick 0
+    uint64_t ticks;         // Ticks since the anchor already counted
+} HostTimerA;
+
+static HostTimerA timers[NUM_OF_TIMERS];
+
+/*!
+ * \brief This function gets the highest count of a timer's cycle
+ *
+ * \return CCR0, or 0xFFFF in continuous mode
+ */
+uint32_t HostTimerA_top(const HostTimerA *timer)
+{
+    return timer->mode == TIMER_A_CONTINUOUS_MODE ? 0xFFFF : timer->ccr[0];
+}
+
+/*!
+ * \brief This function gets the number of ticks in a timer's cycle
+ *
+ * Positions 0 to length - 1 go through the counts of one cycle. In up/down
+ * mode the second half of the positions counts back down.
+ *
+ * \return the cycle length, 0 if the timer is stopped
+ */
+uint32_t HostTimerA_length(const HostTimerA *timer)
+{
+    const uint32_t top = HostTimerA_top(timer);
+    if (timer->clockHz == 0 || top == 0)
+    {
+        return 0;
+    }
+    switch (timer->mode)
+    {
+    case TIMER_A_UP_MODE:
+    case TIMER_A_CONTINUOUS_MODE:
+        return top + 1;
+    case TIMER_A_UPDOWN_MODE:
+        return 2 * top;
+    default:
+        return 0;
+    }
+}
+
+uint32_t HostTimerA_position(const HostTimerA *timer)
+{
+    const uint32_t top = HostTimerA_top(timer);
+    if (timer->count > top)
+    {
+        // CCR0 was moved below the count, the timer rolls to 0
+        return 0;
+    }
+    if (timer->mode == TIMER_A_UPDOWN_MODE && timer->down
+            && timer->count != top)
+    {
+        return 2 * top - timer->count;
+    }
+    return timer->count;
+}
+
+void HostTimerA_setPosition(HostTimerA *timer, uint32_t position)
+{
+    const uint32_t top = HostTimerA_top(timer);
+    timer->down = timer->mode == TIMER_A_UPDOWN_MODE && position >= top;
+    timer->count = position > top ? 2 * top - position : position;
+}
+
+/*!
+ * \brief This function gets the ticks until the next count that matters
+ *
+ * \return the number of ticks, at least 1
+ */
+uint32_t HostTimerA_distance(const HostTimerA *timer, uint32_t length)
+{
+    const uint32_t top = HostTimerA_top(timer);
+    const uint32_t position = HostTimerA_position(timer);
+    uint32_t best = length;
+    int n;
+    for (n = -1; n < NUM_OF_CCRS; n++)
+    {
+        // -1 stands for the return to 0
+        if (n >= 0 && timer->capture[n])
+        {
+            continue;
+        }
+        const uint32_t value = n < 0 ? 0 : timer->ccr[n];
+        if (value > top)
+        {
+            continue;
+        }
+        uint32_t targets[2] = { value, value };
+        if (timer->mode == TIMER_A_UPDOWN_MODE && value != 0)
+        {
+            targets[1] = 2 * top - value;
+        }
+        int i;
+        for (i = 0; i < 2; i++)
+        {
+            const uint32_t distance = (targets[i] + length - position - 1)
+                    % length + 1;
+            if (distance < best)
+            {
+                best = distance;
+            }
+        }
+    }
+    return best;
+}
+
+/*!
+ * \brief This function sets the output of a capture/compare unit
+ *
+ * A rising edge of an output wired to the ADC14 triggers it.
+ *
+ * \return None
+ */
+void HostTimerA_setOutput(int index, int n, bool level)
+{
+    HostTimerA *timer = &timers[index];
+    if (level == timer->out[n])
+    {
+        return;
+    }
+    timer->out[n] = level;
+    if (level && (n == 1 || n == 2) && index < 3)
+    {
+        // TA0.1, TA0.2, TA1.1, TA1.2, TA2.1 and TA2.2 are sources 1 - 6
+        HostADC_trigger(ADC_TRIGGER_SOURCE1 * (index * 2 + n));
+    }
+    else if (level && n == 1 && index == 3)
+    {
+        HostADC_trigger(ADC_TRIGGER_SOURCE7);
+    }
+}
+
+/*!
+ * \brief This function runs the output units when the count reaches CCRn
+ *
+ * \return None
+ */
+void HostTimerA_compare(int index, int n)
+{
+    HostTimerA *timer = &timers[index];
+    switch (timer->outputMode[n])
+    {
+    case TIMER_A_OUTPUTMODE_SET:
+    case TIMER_A_OUTPUTMODE_SET_RESET:
+        HostTimerA_setOutput(index, n, true);
+        break;
+    case TIMER_A_OUTPUTMODE_TOGGLE_RESET:
+    case TIMER_A_OUTPUTMODE_TOGGLE:
+    case TIMER_A_OUTPUTMODE_TOGGLE_SET:
+        HostTimerA_setOutput(index, n, !timer->out[n]);
+        break;
+    case TIMER_A_OUTPUTMODE_RESET:
+    case TIMER_A_OUTPUTMODE_RESET_SET:
+        HostTimerA_setOutput(index, n, false);
+        break;
+    }
+}
+
+/*!
+ * \brief This function runs the output units when the count reaches CCR0
+ *
+ * \return None
+ */
+void HostTimerA_compareZero(int index)
+{
+    HostTimerA *timer = &timers[index];
+    int n;
+    for (n = 1; n < NUM_OF_CCRS; n++)
+    {
+        switch (timer->outputMode[n])
+        {
+        case TIMER_A_OUTPUTMODE_TOGGLE_RESET:
+        case TIMER_A_OUTPUTMODE_SET_RESET:
+            HostTimerA_setOutput(index, n, false);
+            break;
+        case TIMER_A_OUTPUTMODE_TOGGLE_SET:
+        case TIMER_A_OUTPUTMODE_RESET_SET:
+            HostTimerA_setOutput(index, n, true);
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief This function sets the flags and outputs of the current count
+ *
+ * \return None
+ */
+void HostTimerA_event(int index)
+{
+    HostTimerA *timer = &timers[index];
+    const uint32_t position = HostTimerA_position(timer);
+    int n;
+    for (n = 0; n < NUM_OF_CCRS; n++)
+    {
+        if (!timer->capture[n] && timer->ccr[n] == timer->count)
+        {
+            timer->ccifg[n] = true;
+            HostTimerA_compare(index, n);
+        }
+    }
+    if (!timer->capture[0] && timer->count == timer->ccr[0])
+    {
+        if (timer->mode != TIMER_A_CONTINUOUS_MODE)
+        {
+            HostTimerA_compareZero(index);
+        }
+        // CCR0 of each timer is a DMA trigger, TA1 is on channel 2
+        HostDMA_request(DMA_CH2_TIMERA1CCR0 - TIMER_A1_CCR0_TRIGGER
+                + index * 2);
+    }
+    if (position == 0)
+    {
+        timer->taifg = true;
+    }
+    HostCore_update(INT_TA0_0 + index * 2);
+    HostCore_update(INT_TA0_N + index * 2);
+}
+
+/*!
+ * \brief This function checks whether anything sees the events of a timer
+ *
+ * Events are seen through an enabled interrupt, the DMA trigger of CCR0, or
+ * an output that is the trigger of the ADC14. Flags without an interrupt are
+ * only seen when read, so they can be set late.
+ *
+ * \return true if the timer's events have to run on time
+ */
+bool HostTimerA_watched(int index)
+{
+    const HostTimerA *timer = &timers[index];
+    if (timer->taie)
+    {
+        return true;
+    }
+    int n;
+    for (n = 0; n < NUM_OF_CCRS; n++)
+    {
+        if (timer->ccie[n])
+        {
+            return true;
+        }
+    }
+    if (HostDMA_isMapped(DMA_CH2_TIMERA1CCR0 - TIMER_A1_CCR0_TRIGGER
+            + index * 2))
+    {
+        return true;
+    }
+    if (index < 3)
+    {
+        return HostADC_isTrigger(ADC_TRIGGER_SOURCE1 * (index * 2 + 1))
+                || HostADC_isTrigger(ADC_TRIGGER_SOURCE1 * (index * 2 + 2));
+    }
+    return HostADC_isTrigger(ADC_TRIGGER_SOURCE7);
+}
+
+/*!
+ * \brief This function moves a timer nothing watches by whole cycles
+ *
+ * Every compare in the cycle has set its flag. The outputs end up where one
+ * more cycle leaves them, except in toggle mode where the number of toggles
+ * decides.
+ *
+ * \param cycles is the number of cycles to skip
+ * \param length is the length of a cycle
+ *
+ * \return None
+ */
+void HostTimerA_skip(int index, uint64_t cycles, uint32_t length)
+{
+    HostTimerA *timer = &timers[index];
+    const uint32_t top = HostTimerA_top(timer);
+    int n;
+    for (n = 0; n < NUM_OF_CCRS; n++)
+    {
+        if (timer->capture[n] || timer->ccr[n] > top)
+        {
+            continue;
+        }
+        timer->ccifg[n] = true;
+        if (timer->outputMode[n] == TIMER_A_OUTPUTMODE_TOGGLE)
+        {
+            // Up/down mode passes CCRn twice, unless it's 0 or the top
+            const uint64_t toggles = timer->mode == TIMER_A_UPDOWN_MODE
+                    && timer->ccr[n] != 0 && timer->ccr[n] != top ?
+                    2 * cycles : cycles;
+            timer->out[n] ^= toggles & 1;
+        }
+    }
+    timer->taifg = true;
+    timer->ticks += cycles * length;
+}
+
+/*!
+ * \brief This function counts a timer up to a virtual time
+ *
+ * \param time is the virtual time to count to
+ * \param events is false to only move the count, when no event can be due
+ *
+ * \return None
+ */
+void HostTimerA_count(int index, uint64_t time, bool events)
+{
+    HostTimerA *timer = &timers[index];
+    const uint32_t length = HostTimerA_length(timer);
+    if (length == 0)
+    {
+        return;
+    }
+    const uint64_t total = HostCore_timeToTicks(time - timer->anchor,
+                                                timer->clockHz)
+            / timer->divider;
+    // The last two cycles run event by event to leave the outputs right
+    if (total > timer->ticks && total - timer->ticks > 2 * (uint64_t) length
+            && !HostTimerA_watched(index))
+    {
+        HostTimerA_skip(index, (total - timer->ticks) / length - 1, length);
+    }
+    while (timer->ticks < total)
+    {
+        uint32_t distance = HostTimerA_distance(timer, length);
+        const bool due = timer->ticks + distance <= total;
+        if (!due)
+        {
+            distance = total - timer->ticks;
+        }
+        HostTimerA_setPosition(
+                timer, (HostTimerA_position(timer) + distance) % length);
+        timer->ticks += distance;
+        if (due && events)
+        {
+            HostTimerA_event(index);
+        }
+    }
+}
+
+/*!
+ * \brief This function schedules the next event of a timer
+ *
+ * \return None
+ */
+void HostTimerA_schedule(int index)
+{
+    HostTimerA *timer = &timers[index];
+    const uint32_t length = HostTimerA_length(timer);
+    uint64_t time = HOST_NEVER;
+    if (length && HostTimerA_watched(index))
+    {
+        const uint64_t tick = timer->ticks
+                + HostTimerA_distance(timer, length);
+        time = timer->anchor
+                + HostCore_ticksToTime(tick * timer->divider, timer->clockHz);
+    }
+    HostCore_schedule(HOST_TIMER_A0 + index, time);
+}
+
+/*!
+ * \brief This function brings a timer up to the virtual time before a
+ *          register access
+ *
+ * \return the timer
+ */
+HostTimerA* HostTimerA_sync(uint32_t base)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    const int index = TIMER_INDEX(base);
+    HostTimerA_count(index, hostNow, true);
+    return &timers[index];
+}
+
+/*!
+ * \brief This function restarts the tick count of a timer from now
+ *
+ * This is done when the timer starts or its clock changes.
+ *
+ * \return None
+ */
+void HostTimerA_anchor(HostTimerA *timer)
+{
+    switch (timer->source)
+    {
+    case TIMER_A_CLOCKSOURCE_ACLK:
+        timer->clockHz = HostClock_getACLK();
+        break;
+    case TIMER_A_CLOCKSOURCE_SMCLK:
+        timer->clockHz = HostClock_getSMCLK();
+        break;
+    default:
+        timer->clockHz = 0;
+    }
+    timer->anchor = hostNow;
+    timer->ticks = 0;
+}
+
+/*!
+ * \brief This function sets up a timer's clock, like writing TAxCTL
+ *
+ * \return None
+ */
+void HostTimerA_configure(uint32_t base, uint_fast16_t source,
+                          uint_fast16_t divider, uint_fast16_t mode,
+                          bool clear)
+{
+    HostTimerA *timer = &timers[TIMER_INDEX(base)];
+    timer->source = source;
+    timer->divider = divider;
+    timer->mode = mode;
+    if (clear)
+    {
+        timer->count = 0;
+        timer->down = false;
+    }
+    HostTimerA_anchor(timer);
+    HostTimerA_schedule(TIMER_INDEX(base));
+}
+
+/* Level of the CCR0 and the CCR1 - CCR4/overflow interrupt of each timer */
+#define TIMER_LEVELS(i) \
+    bool HostTimerA_level##i##_0(void) \
+    { \
+        return timers[i].ccie[0] && timers[i].ccifg[0]; \
+    } \
+    bool HostTimerA_level##i##_N(void) \
+    { \
+        int n; \
+        for (n = 1; n < NUM_OF_CCRS; n++) \
+        { \
+            if (timers[i].ccie[n] && timers[i].ccifg[n]) \
+            { \
+                return true; \
+            } \
+        } \
+        return timers[i].taie && timers[i].taifg; \
+    }
+
+TIMER_LEVELS(0)
+TIMER_LEVELS(1)
+TIMER_LEVELS(2)
+TIMER_LEVELS(3)
+
+void HostTimerA_init(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        timers[index].divider = 1;
+    }
+    HostCore_setLevel(INT_TA0_0, HostTimerA_level0_0);
+    HostCore_setLevel(INT_TA0_N, HostTimerA_level0_N);
+    HostCore_setLevel(INT_TA1_0, HostTimerA_level1_0);
+    HostCore_setLevel(INT_TA1_N, HostTimerA_level1_N);
+    HostCore_setLevel(INT_TA2_0, HostTimerA_level2_0);
+    HostCore_setLevel(INT_TA2_N, HostTimerA_level2_N);
+    HostCore_setLevel(INT_TA3_0, HostTimerA_level3_0);
+    HostCore_setLevel(INT_TA3_N, HostTimerA_level3_N);
+}
+
+void HostTimerA_run(int index, uint64_t time)
+{
+    HostTimerA_count(index, time, true);
+    HostTimerA_schedule(index);
+}
+
+void HostTimerA_watchChanging(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        HostTimerA_count(index, hostNow, true);
+    }
+}
+
+void HostTimerA_watchChanged(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        HostTimerA_schedule(index);
+    }
+}
+
+void HostTimerA_clockChanged(void)
+{
+    int index;
+    for (index = 0; index < NUM_OF_TIMERS; index++)
+    {
+        HostTimerA_count(index, hostNow, false);
+        HostTimerA_anchor(&timers[index]);
+        HostTimerA_schedule(index);
+    }
+}
+
+uint16_t HAL_readTimerCount(uint32_t timer)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    const int index = TIMER_INDEX(timer);
+    HostTimerA_count(index, hostNow, false);
+    return timers[index].count;
+}
+
+bool HAL_isTimerOverflowPending(uint32_t timer)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    return timers[TIMER_INDEX(timer)].taifg;
+}
+
+uint16_t HAL_readTimerVector(uint32_t timer)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    HostTimerA *state = &timers[TIMER_INDEX(timer)];
+    int n;
+    // Only enabled flags show up, the lowest CCR first
+    for (n = 1; n < NUM_OF_CCRS; n++)
+    {
+        if (state->ccie[n] && state->ccifg[n])
+        {
+            state->ccifg[n] = false;
+            return n * 2;
+        }
+    }
+    if (state->taie && state->taifg)
+    {
+        state->taifg = false;
+        return TAIV_TAIFG;
+    }
+    return 0;
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    if (state->mode == TIMER_A_STOP_MODE)
+    {
+        HostTimerA_anchor(state);
+    }
+    state->mode = timerMode;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_configureContinuousMode(uint32_t timer,
+                                     const Timer_A_ContinuousModeConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->taie = config->timerInterruptEnable_TAIE != 0;
+    HostTimerA_configure(timer, config->clockSource, config->clockSourceDivider,
+                         TIMER_A_STOP_MODE, config->timerClear);
+}
+
+void Timer_A_configureUpMode(uint32_t timer,
+                             const Timer_A_UpModeConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->taie = config->timerInterruptEnable_TAIE != 0;
+    state->ccie[0] = config->captureCompareInterruptEnable_CCR0_CCIE != 0;
+    state->capture[0] = false;
+    state->ccr[0] = config->timerPeriod;
+    HostTimerA_configure(timer, config->clockSource, config->clockSourceDivider,
+                         TIMER_A_STOP_MODE, config->timerClear);
+}
+
+void Timer_A_configureUpDownMode(uint32_t timer,
+                                 const Timer_A_UpDownModeConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->taie = config->timerInterruptEnable_TAIE != 0;
+    state->ccie[0] = config->captureCompareInterruptEnable_CCR0_CCIE != 0;
+    state->capture[0] = false;
+    state->ccr[0] = config->timerPeriod;
+    HostTimerA_configure(timer, config->clockSource, config->clockSourceDivider,
+                         TIMER_A_STOP_MODE, config->timerClear);
+}
+
+void Timer_A_initCapture(uint32_t timer,
+                         const Timer_A_CaptureModeConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    const int n = CCR_INDEX(config->captureRegister);
+    state->capture[n] = true;
+    state->ccie[n] = config->captureInterruptEnable != 0;
+    state->outputMode[n] = config->captureOutputMode;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_initCompare(uint32_t timer,
+                         const Timer_A_CompareModeConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    const int n = CCR_INDEX(config->compareRegister);
+    state->capture[n] = false;
+    state->ccie[n] = config->compareInterruptEnable != 0;
+    state->outputMode[n] = config->compareOutputMode;
+    state->ccr[n] = config->compareValue;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_generatePWM(uint32_t timer, const Timer_A_PWMConfig *config)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    const int n = CCR_INDEX(config->compareRegister);
+    state->taie = false;
+    state->ccr[0] = config->timerPeriod;
+    state->ccie[0] = false;
+    state->outputMode[0] = TIMER_A_OUTPUTMODE_OUTBITVALUE;
+    // DriverLib ORs the mode in
+    state->capture[n] = false;
+    state->outputMode[n] |= config->compareOutputMode;
+    state->ccr[n] = config->dutyCycle;
+    HostTimerA_configure(timer, config->clockSource, config->clockSourceDivider,
+                         TIMER_A_UP_MODE, true);
+}
+
+void Timer_A_stopTimer(uint32_t timer)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->mode = TIMER_A_STOP_MODE;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_clearTimer(uint32_t timer)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->count = 0;
+    state->down = false;
+    HostTimerA_anchor(state);
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+uint_fast16_t Timer_A_getCounterValue(uint32_t timer)
+{
+    return HostTimerA_sync(timer)->count;
+}
+
+void Timer_A_setCompareValue(uint32_t timer, uint_fast16_t compareRegister,
+                             uint_fast16_t compareValue)
+{
+    HostTimerA *state = HostTimerA_sync(timer);
+    state->ccr[CCR_INDEX(compareRegister)] = compareValue;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+volatile void* HAL_getTimerCompareAddress(uint32_t timer,
+                                          uint_fast16_t compareRegister)
+{
+    return &timers[TIMER_INDEX(timer)].ccr[CCR_INDEX(compareRegister)];
+}
+
+uint_fast16_t Timer_A_getCaptureCompareCount(
+        uint32_t timer, uint_fast16_t captureCompareRegister)
+{
+    return HostTimerA_sync(timer)->ccr[CCR_INDEX(captureCompareRegister)];
+}
+
+void Timer_A_enableInterrupt(uint32_t timer)
+{
+    HostTimerA_sync(timer)->taie = true;
+    HostCore_update(INT_TA0_N + TIMER_INDEX(timer) * 2);
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_disableInterrupt(uint32_t timer)
+{
+    HostTimerA_sync(timer)->taie = false;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+uint32_t Timer_A_getInterruptStatus(uint32_t timer)
+{
+    return HostTimerA_sync(timer)->taifg ? TIMER_A_CTL_IFG : 0;
+}
+
+void Timer_A_clearInterruptFlag(uint32_t timer)
+{
+    HostTimerA_sync(timer)->taifg = false;
+}
+
+void Timer_A_enableCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister)
+{
+    const int n = CCR_INDEX(captureCompareRegister);
+    HostTimerA_sync(timer)->ccie[n] = true;
+    HostCore_update((n ? INT_TA0_N : INT_TA0_0) + TIMER_INDEX(timer) * 2);
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+void Timer_A_disableCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister)
+{
+    HostTimerA_sync(timer)->ccie[CCR_INDEX(captureCompareRegister)] = false;
+    HostTimerA_schedule(TIMER_INDEX(timer));
+}
+
+uint32_t Timer_A_getCaptureCompareInterruptStatus(
+        uint32_t timer, uint_fast16_t captureCompareRegister,
+        uint_fast16_t mask)
+{
+    const HostTimerA *state = HostTimerA_sync(timer);
+    return state->ccifg[CCR_INDEX(captureCompareRegister)] ?
+            (mask & TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG) : 0;
+}
+
+void Timer_A_clearCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister)
+{
+    HostTimerA_sync(timer)->ccifg[CCR_INDEX(captureCompareRegister)] = false;
+}
@@ -0,0 +1,169 @@
+/*
+ * HostTrace.c
+ *
+ * Description: Decodes a recording of the flight recorder, see Trace.h, into
+ *              CSV on stdout, oldest event first:
+ *
+ *                  capstone_trace <recording>
+ *
+ *              The recording is a copy of traceRecorder: the HOST_NOINIT file
+ *              of the simulated board, the file capstone_telemetry -t writes
+ *              from what the board sends after a warm reset, or a binary dump
+ *              of traceRecorder saved from the debugger.
+ *
+ *  Created on: Mar 10, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+/* Standard Includes */
+#include <stdio.h>
+
+#include <Host.h>
+#include <Trace.h>
+#include <Timebase.h>
+
+#define NUM_OF_TASKS                                                7
+#define DETAIL_LENGTH                                               32
+
+static const char *const eventNames[NUM_OF_TRACE_EVENTS] = {
+        "boot", "game_start", "task_start", "task_done", "penalty", "key",
+        "switch", "window", "lcd_flush", "fired", "salary" };
+/* In the order of Tasks in main.c */
+static const char *const taskNames[NUM_OF_TASKS] = {
+        "Password", "Lights", "Temp", "Direction", "Power", "Reaction",
+        "Binary" };
+static const char *const difficultyNames[] = { "Easy", "Medium", "Hard" };
+
+static TraceRecorder recorder;
+
+/*!
+ * \brief This function reads a varint of the recording
+ *
+ * \param at is the offset of the varint, moved past it
+ *
+ * \return the value of the varint
+ */
+uint32_t Trace_read(uint32_t *at)
+{
+    uint32_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = recorder.ring[*at];
+        *at = (*at + 1) % TRACE_RING_SIZE;
+        value |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while ((byte & 0x80) && shift < 35);
+    return value;
+}
+
+/*!
+ * \brief This function describes the value of an event
+ *
+ * \param detail gets the description, empty if there's nothing to add
+ *
+ * \return None
+ */
+void Trace_describe(char *detail, int event, uint32_t value)
+{
+    static const char *const switchNames[] = {
+            "", "S1", "", "", "S2", "Button", "", "" };
+    detail[0] = '\0';
+    switch (event)
+    {
+    case TRACE_BOOT:
+        snprintf(detail, DETAIL_LENGTH, "%s",
+                 value ? "warm reset" : "cold start");
+        break;
+    case TRACE_GAME_START:
+        if (value < 3)
+        {
+            snprintf(detail, DETAIL_LENGTH, "%s", difficultyNames[value]);
+        }
+        break;
+    case TRACE_TASK_START:
+    case TRACE_TASK_DONE:
+    case TRACE_FIRED:
+        if (value < NUM_OF_TASKS)
+        {
+            snprintf(detail, DETAIL_LENGTH, "%s", taskNames[value]);
+        }
+        break;
+    case TRACE_KEY:
+        snprintf(detail, DETAIL_LENGTH, "%c %s", (char) (value & 0xFF),
+                 value & 0x100 ? "pressed" : "released");
+        break;
+    case TRACE_SWITCH:
+        snprintf(detail, DETAIL_LENGTH, "%s %s", switchNames[(value / 2) & 7],
+                 value & 1 ? "pressed" : "released");
+        break;
+    case TRACE_WINDOW:
+        snprintf(detail, DETAIL_LENGTH, "%s", value ? "above" : "below");
+        break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <recording>\n", argv[0]);
+        return HOST_EXIT_USAGE;
+    }
+    FILE *file = fopen(argv[1], "rb");
+    if (!file)
+    {
+        perror(argv[1]);
+        return HOST_EXIT_USAGE;
+    }
+    const size_t got = fread(&recorder, 1, sizeof(recorder), file);
+    fclose(file);
+    // Same checks as Trace_init
+    if (got != sizeof(recorder) || recorder.magic != TRACE_MAGIC
+            || recorder.head >= TRACE_RING_SIZE
+            || recorder.tail >= TRACE_RING_SIZE
+            || recorder.used > TRACE_RING_SIZE
+            || (recorder.tail + recorder.used) % TRACE_RING_SIZE
+                    != recorder.head)
+    {
+        fprintf(stderr, "%s: not a recording\n", argv[1]);
+        return HOST_EXIT_USAGE;
+    }
+
+    printf("ticks,ms,event,value,detail\n");
+    uint32_t time = recorder.baseTime;
+    uint32_t at = recorder.tail;
+    uint32_t left = recorder.used;
+    unsigned long events = 0;
+    while (left > 0)
+    {
+        const uint32_t start = at;
+        const uint8_t first = recorder.ring[at];
+        at = (at + 1) % TRACE_RING_SIZE;
+        time += Trace_read(&at);
+        uint32_t value = first & 0x0F;
+        if (value == TRACE_SMALL_VALUES)
+        {
+            value += Trace_read(&at);
+        }
+        const uint32_t length = (at - start) % TRACE_RING_SIZE;
+        const int event = first >> 4;
+        if (length > left || event >= NUM_OF_TRACE_EVENTS)
+        {
+            fprintf(stderr, "%s: bad event at offset %u\n", argv[1], start);
+            return HOST_EXIT_USAGE;
+        }
+        left -= length;
+
+        char detail[DETAIL_LENGTH];
+        Trace_describe(detail, event, value);
+        printf("%u,%.3f,%s,%u,%s\n", time, time * 1000.0 / TIMEBASE_HZ,
+               eventNames[event], value, detail);
+        events++;
+    }
+    fprintf(stderr, "%lu events, %lu older ones overwritten\n", events,
+            (unsigned long) recorder.events - events);
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * HostUART.c
+ *
+ * Description: Helper file for the simulated eUSCI_A0 UART, transmit only.
+ *              A byte written to TXBUF moves to the shift register as soon as
+ *              it's free, which sets UCTXIFG and requests the uDMA. A byte
+ *              takes 10 bit times to send, 1 start, 8 data and 1 stop bit.
+ *              When it's out and TXBUF is empty UCTXCPTIFG is set. Sent bytes
+ *              are written to the file named by HOST_UART. A byte being sent
+ *              keeps the bit time it started with when the clock changes.
+ *
+ *  Created on: Mar 9, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+#include <HostPrivate.h>
+
+/* Standard Includes */
+#include <stdlib.h>
+
+#define BITS_PER_BYTE                                               10
+#define UART_FLAGS                                                  0x0F
+
+typedef struct _HostUART
+{
+    bool on;
+    bool smclk;             // Clocked by SMCLK, otherwise by ACLK
+    uint32_t clocksPerBit;
+    volatile uint8_t txbuf; // Written by the CPU or the uDMA
+    bool txbufFull;
+    bool shifting;
+    uint8_t shifter;
+    uint8_t enabled;        // EUSCI_A_UART_*_INTERRUPT
+    uint8_t flags;          // EUSCI_A_UART_*_INTERRUPT_FLAG
+    FILE *sink;
+} HostUART;
+
+static HostUART uart = { .flags = EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG };
+
+bool HostUART_level(void)
+{
+    return (uart.enabled & uart.flags) != 0;
+}
+
+/*!
+ * \brief This function moves TXBUF into the shift register
+ *
+ * \return None
+ */
+void HostUART_shift(void)
+{
+    const uint32_t hz = uart.smclk ?
+            HostClock_getSMCLK() : HostClock_getACLK();
+    uart.shifter = uart.txbuf;
+    uart.txbufFull = false;
+    uart.shifting = true;
+    HostCore_schedule(
+            HOST_UART,
+            hostNow + HostCore_ticksToTime(
+                    (uint64_t) uart.clocksPerBit * BITS_PER_BYTE, hz));
+    uart.flags |= EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+    HostCore_update(INT_EUSCIA0);
+    // The uDMA may fill TXBUF again right away
+    HostDMA_request(DMA_CH0_EUSCIA0TX);
+}
+
+/*!
+ * \brief This function takes a byte written to TXBUF
+ *
+ * \return None
+ */
+void HostUART_load(void)
+{
+    uart.flags &= ~(EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG
+            | EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT_FLAG);
+    uart.txbufFull = true;
+    if (uart.on && !uart.shifting)
+    {
+        HostUART_shift();
+    }
+}
+
+void HostUART_init(void)
+{
+    HostCore_setLevel(INT_EUSCIA0, HostUART_level);
+    const char *path = getenv("HOST_UART");
+    if (path && !(uart.sink = fopen(path, "wb")))
+    {
+        perror(path);
+        exit(HOST_EXIT_USAGE);
+    }
+}
+
+void HostUART_run(uint64_t time)
+{
+    uart.shifting = false;
+    if (uart.sink)
+    {
+        fputc(uart.shifter, uart.sink);
+    }
+    if (uart.txbufFull)
+    {
+        HostUART_shift();
+    }
+    else
+    {
+        uart.flags |= EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT_FLAG;
+        HostCore_update(INT_EUSCIA0);
+    }
+}
+
+void HostUART_written(const volatile void *address)
+{
+    if (address == &uart.txbuf)
+    {
+        HostUART_load();
+    }
+}
+
+volatile void* HAL_getUARTTransmitAddress(void)
+{
+    HostCore_call(HOST_ACCESS_CYCLES);
+    return &uart.txbuf;
+}
+
+bool UART_initModule(uint32_t moduleInstance,
+                     const eUSCI_UART_ConfigV1 *config)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    // UCSWRST is set, which stops the UART and resets its flags
+    uart.on = false;
+    uart.shifting = false;
+    uart.txbufFull = false;
+    uart.enabled = 0;
+    uart.flags = EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+    HostCore_schedule(HOST_UART, HOST_NEVER);
+    uart.smclk = config->selectClockSource == EUSCI_A_UART_CLOCKSOURCE_SMCLK;
+    // UCBRSx only spreads the fraction over the bits of a byte
+    uart.clocksPerBit =
+            config->overSampling ?
+                    16 * config->clockPrescalar + config->firstModReg :
+                    config->clockPrescalar;
+    return true;
+}
+
+void UART_enableModule(uint32_t moduleInstance)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.on = true;
+}
+
+void UART_disableModule(uint32_t moduleInstance)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.on = false;
+}
+
+void UART_transmitData(uint32_t moduleInstance, uint_fast8_t transmitData)
+{
+    // DriverLib waits for TXBUF to be empty
+    while (!(uart.flags & EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG))
+    {
+        HostCore_call(HOST_ACCESS_CYCLES);
+    }
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.txbuf = transmitData;
+    HostUART_load();
+}
+
+void UART_enableInterrupt(uint32_t moduleInstance, uint_fast8_t mask)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.enabled |= mask & UART_FLAGS;
+    HostCore_update(INT_EUSCIA0);
+}
+
+void UART_disableInterrupt(uint32_t moduleInstance, uint_fast8_t mask)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.enabled &= ~mask;
+}
+
+uint_fast8_t UART_getInterruptStatus(uint32_t moduleInstance, uint8_t mask)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return uart.flags & mask;
+}
+
+uint_fast8_t UART_getEnabledInterruptStatus(uint32_t moduleInstance)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    return uart.flags & uart.enabled;
+}
+
+void UART_clearInterruptFlag(uint32_t moduleInstance, uint_fast8_t mask)
+{
+    HostCore_call(HOST_CALL_CYCLES);
+    uart.flags &= ~mask;
+}
@@ -0,0 +1,677 @@
+/*
+ * driverlib.h
+ *
+ * Description: Host version of the MSP432 DriverLib header. It declares the
+ *              part of DriverLib the firmware uses, with the same names and
+ *              values as the SimpleLink SDK, and is implemented by the
+ *              simulated peripherals in host/. Register structures are not
+ *              provided, the firmware reaches them only through HAL.h.
+ *
+ *  Created on: Mar 6, 2021
+ *      Author: Cooper Brotherton and Jesus Capo
+ */
+
+#ifndef HOST_DRIVERLIB_H_
+#define HOST_DRIVERLIB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Standard Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------------------------------------------------------------- Interrupts */
+
+#define FAULT_PENDSV                                                14
+#define FAULT_SYSTICK                                               15
+#define INT_PSS                                                     16
+#define INT_CS                                                      17
+#define INT_PCM                                                     18
+#define INT_WDT_A                                                   19
+#define INT_FPU                                                     20
+#define INT_FLCTL                                                   21
+#define INT_COMP_E0                                                 22
+#define INT_COMP_E1                                                 23
+#define INT_TA0_0                                                   24
+#define INT_TA0_N                                                   25
+#define INT_TA1_0                                                   26
+#define INT_TA1_N                                                   27
+#define INT_TA2_0                                                   28
+#define INT_TA2_N                                                   29
+#define INT_TA3_0                                                   30
+#define INT_TA3_N                                                   31
+#define INT_EUSCIA0                                                 32
+#define INT_EUSCIA1                                                 33
+#define INT_EUSCIA2                                                 34
+#define INT_EUSCIA3                                                 35
+#define INT_EUSCIB0                                                 36
+#define INT_EUSCIB1                                                 37
+#define INT_EUSCIB2                                                 38
+#define INT_EUSCIB3                                                 39
+#define INT_ADC14                                                   40
+#define INT_T32_INT1                                                41
+#define INT_T32_INT2                                                42
+#define INT_T32_INTC                                                43
+#define INT_AES256                                                  44
+#define INT_RTC_C                                                   45
+#define INT_DMA_ERR                                                 46
+#define INT_DMA_INT3                                                47
+#define INT_DMA_INT2                                                48
+#define INT_DMA_INT1                                                49
+#define INT_DMA_INT0                                                50
+#define INT_PORT1                                                   51
+#define INT_PORT2                                                   52
+#define INT_PORT3                                                   53
+#define INT_PORT4                                                   54
+#define INT_PORT5                                                   55
+#define INT_PORT6                                                   56
+#define NUM_INTERRUPTS                                              64
+
+extern bool Interrupt_enableMaster(void);
+extern bool Interrupt_disableMaster(void);
+extern void Interrupt_enableInterrupt(uint32_t interruptNumber);
+extern void Interrupt_disableInterrupt(uint32_t interruptNumber);
+extern bool Interrupt_isEnabled(uint32_t interruptNumber);
+extern void Interrupt_pendInterrupt(uint32_t interruptNumber);
+extern void Interrupt_unpendInterrupt(uint32_t interruptNumber);
+extern void Interrupt_setPriority(uint32_t interruptNumber, uint8_t priority);
+
+/* ---------------------------------------------------------------------- GPIO */
+
+#define GPIO_PORT_P1                                                1
+#define GPIO_PORT_P2                                                2
+#define GPIO_PORT_P3                                                3
+#define GPIO_PORT_P4                                                4
+#define GPIO_PORT_P5                                                5
+#define GPIO_PORT_P6                                                6
+#define GPIO_PORT_P7                                                7
+#define GPIO_PORT_P8                                                8
+#define GPIO_PORT_P9                                                9
+#define GPIO_PORT_P10                                               10
+#define GPIO_PORT_PJ                                                11
+
+#define GPIO_PIN0                                                   0x0001
+#define GPIO_PIN1                                                   0x0002
+#define GPIO_PIN2                                                   0x0004
+#define GPIO_PIN3                                                   0x0008
+#define GPIO_PIN4                                                   0x0010
+#define GPIO_PIN5                                                   0x0020
+#define GPIO_PIN6                                                   0x0040
+#define GPIO_PIN7                                                   0x0080
+#define GPIO_PIN_ALL8                                               0x00FF
+
+#define GPIO_PRIMARY_MODULE_FUNCTION                                0x01
+#define GPIO_SECONDARY_MODULE_FUNCTION                              0x02
+#define GPIO_TERTIARY_MODULE_FUNCTION                               0x03
+
+#define GPIO_HIGH_TO_LOW_TRANSITION                                 0x01
+#define GPIO_LOW_TO_HIGH_TRANSITION                                 0x00
+
+#define GPIO_INPUT_PIN_HIGH                                         0x01
+#define GPIO_INPUT_PIN_LOW                                          0x00
+
+extern void GPIO_setAsOutputPin(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_setOutputHighOnPin(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_setOutputLowOnPin(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_toggleOutputOnPin(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_setAsInputPin(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t port,
+                                                 uint_fast16_t pins);
+extern void GPIO_setAsInputPinWithPullDownResistor(uint_fast8_t port,
+                                                   uint_fast16_t pins);
+extern void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t port,
+                                                        uint_fast16_t pins,
+                                                        uint_fast8_t mode);
+extern void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t port,
+                                                       uint_fast16_t pins,
+                                                       uint_fast8_t mode);
+extern uint8_t GPIO_getInputPinValue(uint_fast8_t port, uint_fast16_t pin);
+extern void GPIO_interruptEdgeSelect(uint_fast8_t port, uint_fast16_t pins,
+                                     uint_fast8_t edgeSelect);
+extern void GPIO_enableInterrupt(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_disableInterrupt(uint_fast8_t port, uint_fast16_t pins);
+extern void GPIO_clearInterruptFlag(uint_fast8_t port, uint_fast16_t pins);
+extern uint_fast16_t GPIO_getInterruptStatus(uint_fast8_t port,
+                                             uint_fast16_t pins);
+extern uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t port);
+
+/* -------------------------------------------------------------------- Timer_A */
+
+#define TIMER_A0_BASE                                               0x40000000
+#define TIMER_A1_BASE                                               0x40000400
+#define TIMER_A2_BASE                                               0x40000800
+#define TIMER_A3_BASE                                               0x40000C00
+
+#define TIMER_A_CLOCKSOURCE_EXTERNAL_TXCLK                          0x0000
+#define TIMER_A_CLOCKSOURCE_ACLK                                    0x0100
+#define TIMER_A_CLOCKSOURCE_SMCLK                                   0x0200
+#define TIMER_A_CLOCKSOURCE_INVERTED_EXTERNAL_TXCLK                 0x0300
+
+#define TIMER_A_CLOCKSOURCE_DIVIDER_1                               0x01
+#define TIMER_A_CLOCKSOURCE_DIVIDER_2                               0x02
+#define TIMER_A_CLOCKSOURCE_DIVIDER_3                               0x03
+#define TIMER_A_CLOCKSOURCE_DIVIDER_4                               0x04
+#define TIMER_A_CLOCKSOURCE_DIVIDER_5                               0x05
+#define TIMER_A_CLOCKSOURCE_DIVIDER_6                               0x06
+#define TIMER_A_CLOCKSOURCE_DIVIDER_7                               0x07
+#define TIMER_A_CLOCKSOURCE_DIVIDER_8                               0x08
+#define TIMER_A_CLOCKSOURCE_DIVIDER_10                              0x0A
+#define TIMER_A_CLOCKSOURCE_DIVIDER_12                              0x0C
+#define TIMER_A_CLOCKSOURCE_DIVIDER_14                              0x0E
+#define TIMER_A_CLOCKSOURCE_DIVIDER_16                              0x10
+#define TIMER_A_CLOCKSOURCE_DIVIDER_20                              0x14
+#define TIMER_A_CLOCKSOURCE_DIVIDER_24                              0x18
+#define TIMER_A_CLOCKSOURCE_DIVIDER_28                              0x1C
+#define TIMER_A_CLOCKSOURCE_DIVIDER_32                              0x20
+#define TIMER_A_CLOCKSOURCE_DIVIDER_40                              0x28
+#define TIMER_A_CLOCKSOURCE_DIVIDER_48                              0x30
+#define TIMER_A_CLOCKSOURCE_DIVIDER_56                              0x38
+#define TIMER_A_CLOCKSOURCE_DIVIDER_64                              0x40
+
+#define TIMER_A_STOP_MODE                                           0x0000
+#define TIMER_A_UP_MODE                                             0x0010
+#define TIMER_A_CONTINUOUS_MODE                                     0x0020
+#define TIMER_A_UPDOWN_MODE                                         0x0030
+
+#define TIMER_A_DO_CLEAR                                            0x0004
+#define TIMER_A_SKIP_CLEAR                                          0x0000
+
+#define TIMER_A_TAIE_INTERRUPT_ENABLE                               0x0002
+#define TIMER_A_TAIE_INTERRUPT_DISABLE                              0x0000
+#define TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE                          0x0010
+#define TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE                         0x0000
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_ENABLE                     0x0010
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE                    0x0000
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG                       0x0001
+
+#define TIMER_A_CAPTURECOMPARE_REGISTER_0                           0x02
+#define TIMER_A_CAPTURECOMPARE_REGISTER_1                           0x04
+#define TIMER_A_CAPTURECOMPARE_REGISTER_2                           0x06
+#define TIMER_A_CAPTURECOMPARE_REGISTER_3                           0x08
+#define TIMER_A_CAPTURECOMPARE_REGISTER_4                           0x0A
+
+#define TIMER_A_OUTPUTMODE_OUTBITVALUE                              0x00
+#define TIMER_A_OUTPUTMODE_SET                                      0x20
+#define TIMER_A_OUTPUTMODE_TOGGLE_RESET                             0x40
+#define TIMER_A_OUTPUTMODE_SET_RESET                                0x60
+#define TIMER_A_OUTPUTMODE_TOGGLE                                   0x80
+#define TIMER_A_OUTPUTMODE_RESET                                    0xA0
+#define TIMER_A_OUTPUTMODE_TOGGLE_SET                               0xC0
+#define TIMER_A_OUTPUTMODE_RESET_SET                                0xE0
+
+#define TIMER_A_CAPTUREMODE_NO_CAPTURE                              0x0000
+#define TIMER_A_CAPTUREMODE_RISING_EDGE                             0x4000
+#define TIMER_A_CAPTUREMODE_FALLING_EDGE                            0x8000
+#define TIMER_A_CAPTUREMODE_RISING_AND_FALLING_EDGE                 0xC000
+#define TIMER_A_CAPTURE_INPUTSELECT_CCIxA                           0x0000
+#define TIMER_A_CAPTURE_INPUTSELECT_CCIxB                           0x1000
+#define TIMER_A_CAPTURE_INPUTSELECT_GND                             0x2000
+#define TIMER_A_CAPTURE_INPUTSELECT_Vcc                             0x3000
+#define TIMER_A_CAPTURE_ASYNCHRONOUS                                0x0000
+#define TIMER_A_CAPTURE_SYNCHRONOUS                                 0x0800
+
+#define TIMER_A_CTL_IFG                                             0x0001
+#define TIMER_A_CTL_IE                                              0x0002
+
+typedef struct _Timer_A_ContinuousModeConfig
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerInterruptEnable_TAIE;
+    uint_fast16_t timerClear;
+} Timer_A_ContinuousModeConfig;
+
+typedef struct _Timer_A_UpModeConfig
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerPeriod;
+    uint_fast16_t timerInterruptEnable_TAIE;
+    uint_fast16_t captureCompareInterruptEnable_CCR0_CCIE;
+    uint_fast16_t timerClear;
+} Timer_A_UpModeConfig;
+
+typedef struct _Timer_A_UpDownModeConfig
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerPeriod;
+    uint_fast16_t timerInterruptEnable_TAIE;
+    uint_fast16_t captureCompareInterruptEnable_CCR0_CCIE;
+    uint_fast16_t timerClear;
+} Timer_A_UpDownModeConfig;
+
+typedef struct _Timer_A_CaptureModeConfig
+{
+    uint_fast16_t captureRegister;
+    uint_fast16_t captureMode;
+    uint_fast16_t captureInputSelect;
+    uint_fast16_t synchronizeCaptureSource;
+    uint_fast8_t captureInterruptEnable;
+    uint_fast16_t captureOutputMode;
+} Timer_A_CaptureModeConfig;
+
+typedef struct _Timer_A_CompareModeConfig
+{
+    uint_fast16_t compareRegister;
+    uint_fast16_t compareInterruptEnable;
+    uint_fast16_t compareOutputMode;
+    uint_fast16_t compareValue;
+} Timer_A_CompareModeConfig;
+
+typedef struct _Timer_A_PWMConfig
+{
+    uint_fast16_t clockSource;
+    uint_fast16_t clockSourceDivider;
+    uint_fast16_t timerPeriod;
+    uint_fast16_t compareRegister;
+    uint_fast16_t compareOutputMode;
+    uint_fast16_t dutyCycle;
+} Timer_A_PWMConfig;
+
+extern void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode);
+extern void Timer_A_configureContinuousMode(
+        uint32_t timer, const Timer_A_ContinuousModeConfig *config);
+extern void Timer_A_configureUpMode(uint32_t timer,
+                                    const Timer_A_UpModeConfig *config);
+extern void Timer_A_configureUpDownMode(uint32_t timer,
+                                        const Timer_A_UpDownModeConfig *config);
+extern void Timer_A_initCapture(uint32_t timer,
+                                const Timer_A_CaptureModeConfig *config);
+extern void Timer_A_initCompare(uint32_t timer,
+                                const Timer_A_CompareModeConfig *config);
+extern void Timer_A_generatePWM(uint32_t timer,
+                                const Timer_A_PWMConfig *config);
+extern void Timer_A_stopTimer(uint32_t timer);
+extern void Timer_A_clearTimer(uint32_t timer);
+extern uint_fast16_t Timer_A_getCounterValue(uint32_t timer);
+extern void Timer_A_setCompareValue(uint32_t timer,
+                                    uint_fast16_t compareRegister,
+                                    uint_fast16_t compareValue);
+extern uint_fast16_t Timer_A_getCaptureCompareCount(
+        uint32_t timer, uint_fast16_t captureCompareRegister);
+extern void Timer_A_enableInterrupt(uint32_t timer);
+extern void Timer_A_disableInterrupt(uint32_t timer);
+extern uint32_t Timer_A_getInterruptStatus(uint32_t timer);
+extern void Timer_A_clearInterruptFlag(uint32_t timer);
+extern void Timer_A_enableCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister);
+extern void Timer_A_disableCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister);
+extern uint32_t Timer_A_getCaptureCompareInterruptStatus(
+        uint32_t timer, uint_fast16_t captureCompareRegister,
+        uint_fast16_t mask);
+extern void Timer_A_clearCaptureCompareInterrupt(
+        uint32_t timer, uint_fast16_t captureCompareRegister);
+
+/* -------------------------------------------------------------------- Timer32 */
+
+#define TIMER32_0_BASE                                              0x4000C000
+#define TIMER32_1_BASE                                              0x4000C020
+
+#define TIMER32_PRESCALER_1                                         0x00
+#define TIMER32_PRESCALER_16                                        0x04
+#define TIMER32_PRESCALER_256                                       0x08
+
+#define TIMER32_16BIT                                               0x00
+#define TIMER32_32BIT                                               0x02
+
+#define TIMER32_PERIODIC_MODE                                       0x40
+#define TIMER32_FREE_RUN_MODE                                       0x00
+
+extern void Timer32_initModule(uint32_t timer, uint32_t preScaler,
+                               uint32_t resolution, uint32_t mode);
+extern void Timer32_setCount(uint32_t timer, uint32_t count);
+extern uint32_t Timer32_getValue(uint32_t timer);
+extern void Timer32_startTimer(uint32_t timer, bool oneShot);
+extern void Timer32_haltTimer(uint32_t timer);
+extern void Timer32_enableInterrupt(uint32_t timer);
+extern void Timer32_disableInterrupt(uint32_t timer);
+extern void Timer32_clearInterruptFlag(uint32_t timer);
+extern uint32_t Timer32_getInterruptStatus(uint32_t timer);
+
+/* -------------------------------------------------------------------- SysTick */
+
+extern void SysTick_enableModule(void);
+extern void SysTick_disableModule(void);
+extern void SysTick_enableInterrupt(void);
+extern void SysTick_disableInterrupt(void);
+extern void SysTick_setPeriod(uint32_t period);
+extern uint32_t SysTick_getPeriod(void);
+extern uint32_t SysTick_getValue(void);
+
+/* ---------------------------------------------------------------------- ADC14 */
+
+#define ADC_CLOCKSOURCE_ADCOSC                                      0x00000000
+#define ADC_CLOCKSOURCE_SYSOSC                                      0x00080000
+#define ADC_CLOCKSOURCE_ACLK                                        0x00100000
+#define ADC_CLOCKSOURCE_MCLK                                        0x00180000
+#define ADC_CLOCKSOURCE_SMCLK                                       0x00200000
+#define ADC_CLOCKSOURCE_HSMCLK                                      0x00280000
+
+#define ADC_PREDIVIDER_1                                            0x00000000
+#define ADC_PREDIVIDER_4                                            0x20000000
+#define ADC_PREDIVIDER_32                                           0x40000000
+#define ADC_PREDIVIDER_64                                           0x60000000
+
+#define ADC_DIVIDER_1                                               0x00000000
+#define ADC_DIVIDER_2                                               0x00400000
+#define ADC_DIVIDER_4                                               0x00C00000
+#define ADC_DIVIDER_8                                               0x01C00000
+
+#define ADC_MANUAL_ITERATION                                        0x00000000
+#define ADC_AUTOMATIC_ITERATION                                     0x00000080
+
+#define ADC_8BIT                                                    0x00000000
+#define ADC_10BIT                                                   0x00000010
+#define ADC_12BIT                                                   0x00000020
+#define ADC_14BIT                                                   0x00000030
+
+#define ADC_TRIGGER_ADSC                                            0x00000000
+#define ADC_TRIGGER_SOURCE1                                         0x08000000
+#define ADC_TRIGGER_SOURCE2                                         0x10000000
+#define ADC_TRIGGER_SOURCE3                                         0x18000000
+#define ADC_TRIGGER_SOURCE4                                         0x20000000
+#define ADC_TRIGGER_SOURCE5                                         0x28000000
+#define ADC_TRIGGER_SOURCE6                                         0x30000000
+#define ADC_TRIGGER_SOURCE7                                         0x38000000
+
+#define ADC_UNRESTRICTED_POWER_MODE                                 0x00000000
+#define ADC_ULTRA_LOW_POWER_MODE                                    0x00000002
+
+#define ADC_COMP_WINDOW0                                            0x00
+#define ADC_COMP_WINDOW1                                            0x80
+
+#define ADC_VREFPOS_AVCC_VREFNEG_VSS                                0x00000000
+
+#define ADC_INPUT_A0                                                0
+#define ADC_INPUT_A1                                                1
+#define ADC_INPUT_A2                                                2
+#define ADC_INPUT_A3                                                3
+#define ADC_INPUT_A4                                                4
+#define ADC_INPUT_A5                                                5
+#define ADC_INPUT_A6                                                6
+#define ADC_INPUT_A7                                                7
+#define ADC_NUM_INPUTS                                              24
+
+#define ADC_MEM0                                                    0x00000001
+#define ADC_MEM1                                                    0x00000002
+#define ADC_MEM2                                                    0x00000004
+#define ADC_MEM3                                                    0x00000008
+#define ADC_MEM4                                                    0x00000010
+#define ADC_MEM5                                                    0x00000020
+#define ADC_MEM6                                                    0x00000040
+#define ADC_MEM7                                                    0x00000080
+
+#define ADC_INT0                                            0x0000000000000001
+#define ADC_INT1                                            0x0000000000000002
+#define ADC_INT2                                            0x0000000000000004
+#define ADC_IN_INT                                          0x0000000200000000
+#define ADC_LO_INT                                          0x0000000400000000
+#define ADC_HI_INT                                          0x0000000800000000
+#define ADC_OV_INT                                          0x0000001000000000
+#define ADC_TOV_INT                                         0x0000002000000000
+#define ADC_RDY_INT                                         0x0000004000000000
+
+extern bool ADC14_enableModule(void);
+extern bool ADC14_disableModule(void);
+extern bool ADC14_initModule(uint32_t clockSource, uint32_t clockPredivider,
+                             uint32_t clockDivider, uint32_t internalChannelMask);
+extern bool ADC14_enableSampleTimer(uint32_t multiSampleConvert);
+extern bool ADC14_disableSampleTimer(void);
+extern void ADC14_setResolution(uint32_t resolution);
+extern bool ADC14_setPowerMode(uint32_t powerMode);
+extern bool ADC14_configureSingleSampleMode(uint32_t memoryDestination,
+                                            bool repeatMode);
+extern bool ADC14_configureMultiSequenceMode(uint32_t memoryStart,
+                                             uint32_t memoryEnd,
+                                             bool repeatMode);
+extern bool ADC14_configureConversionMemory(uint32_t memorySelect,
+                                            uint32_t refSelect,
+                                            uint32_t channelSelect,
+                                            bool differntialMode);
+extern bool ADC14_setSampleHoldTrigger(uint32_t source, bool invertSignal);
+extern bool ADC14_enableConversion(void);
+extern void ADC14_disableConversion(void);
+extern bool ADC14_toggleConversionTrigger(void);
+extern bool ADC14_isBusy(void);
+extern uint_fast16_t ADC14_getResult(uint32_t memorySelect);
+extern bool ADC14_setComparatorWindowValue(uint32_t window, int16_t low,
+                                           int16_t high);
+extern bool ADC14_enableComparatorWindow(uint32_t memorySelect,
+                                         uint32_t windowSelect);
+extern bool ADC14_disableComparatorWindow(uint32_t memorySelect);
+extern void ADC14_enableInterrupt(uint_fast64_t mask);
+extern void ADC14_disableInterrupt(uint_fast64_t mask);
+extern uint_fast64_t ADC14_getInterruptStatus(void);
+extern uint_fast64_t ADC14_getEnabledInterruptStatus(void);
+extern void ADC14_clearInterruptFlag(uint_fast64_t mask);
+
+/* ------------------------------------------------------------------------ DMA */
+
+#define DMA_CH0_EUSCIA0TX                                           0x01000000
+#define DMA_CH2_TIMERA1CCR0                                         0x06000002
+#define DMA_CH7_ADC14                                               0x07000007
+
+#define DMA_INT0                                                    INT_DMA_INT0
+#define DMA_INT1                                                    INT_DMA_INT1
+#define DMA_INT2                                                    INT_DMA_INT2
+#define DMA_INT3                                                    INT_DMA_INT3
+
+#define UDMA_PRI_SELECT                                             0x00000000
+#define UDMA_ALT_SELECT                                             0x00000008
+
+#define UDMA_ATTR_USEBURST                                          0x00000001
+#define UDMA_ATTR_ALTSELECT                                         0x00000002
+#define UDMA_ATTR_HIGH_PRIORITY                                     0x00000004
+#define UDMA_ATTR_REQMASK                                           0x00000008
+#define UDMA_ATTR_ALL                                               0x0000000F
+
+#define UDMA_MODE_STOP                                              0x00000000
+#define UDMA_MODE_BASIC                                             0x00000001
+#define UDMA_MODE_AUTO                                              0x00000002
+#define UDMA_MODE_PINGPONG                                          0x00000003
+
+#define UDMA_SIZE_8                                                 0x00000000
+#define UDMA_SIZE_16                                                0x11000000
+#define UDMA_SIZE_32                                                0x22000000
+#define UDMA_SRC_INC_8                                              0x00000000
+#define UDMA_SRC_INC_16                                             0x04000000
+#define UDMA_SRC_INC_32                                             0x08000000
+#define UDMA_SRC_INC_NONE                                           0x0C000000
+#define UDMA_DST_INC_8                                              0x00000000
+#define UDMA_DST_INC_16                                             0x40000000
+#define UDMA_DST_INC_32                                             0x80000000
+#define UDMA_DST_INC_NONE                                           0xC0000000
+#define UDMA_ARB_1                                                  0x00000000
+#define UDMA_ARB_2                                                  0x00004000
+#define UDMA_ARB_4                                                  0x00008000
+#define UDMA_ARB_8                                                  0x0000C000
+#define UDMA_ARB_16                                                 0x00010000
+#define UDMA_ARB_32                                                 0x00014000
+#define UDMA_ARB_64                                                 0x00018000
+#define UDMA_ARB_128                                                0x0001C000
+#define UDMA_ARB_256                                                0x00020000
+#define UDMA_ARB_512                                                0x00024000
+#define UDMA_ARB_1024                                               0x00028000
+
+typedef struct _DMA_ControlTable
+{
+    volatile void *srcEndAddr;
+    volatile void *dstEndAddr;
+    volatile uint32_t control;
+    volatile uint32_t spare;
+} DMA_ControlTable;
+
+extern void DMA_enableModule(void);
+extern void DMA_disableModule(void);
+extern void DMA_setControlBase(void *controlTable);
+extern void DMA_assignChannel(uint32_t mapping);
+extern void DMA_enableChannel(uint32_t channelNum);
+extern void DMA_disableChannel(uint32_t channelNum);
+extern bool DMA_isChannelEnabled(uint32_t channelNum);
+extern void DMA_enableChannelAttribute(uint32_t channelNum, uint32_t attr);
+extern void DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr);
+extern uint32_t DMA_getChannelAttribute(uint32_t channelNum);
+extern void DMA_setChannelControl(uint32_t channelStructIndex,
+                                  uint32_t control);
+extern void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                                   void *srcAddr, void *dstAddr,
+                                   uint32_t transferSize);
+extern uint32_t DMA_getChannelMode(uint32_t channelStructIndex);
+extern uint32_t DMA_getChannelSize(uint32_t channelStructIndex);
+extern void DMA_requestSoftwareTransfer(uint32_t channel);
+extern void DMA_assignInterrupt(uint32_t interruptNumber, uint32_t channel);
+extern void DMA_enableInterrupt(uint32_t interruptNumber);
+extern void DMA_disableInterrupt(uint32_t interruptNumber);
+extern uint32_t DMA_getInterruptStatus(void);
+extern void DMA_clearInterruptFlag(uint32_t intChannel);
+
+/* ----------------------------------------------------------------------- UART */
+
+#define EUSCI_A0_BASE                                               0x40001000
+
+#define EUSCI_A_UART_NO_PARITY                                      0x00
+#define EUSCI_A_UART_ODD_PARITY                                     0x01
+#define EUSCI_A_UART_EVEN_PARITY                                    0x02
+#define EUSCI_A_UART_MSB_FIRST                                      0x2000
+#define EUSCI_A_UART_LSB_FIRST                                      0x00
+#define EUSCI_A_UART_MODE                                           0x00
+#define EUSCI_A_UART_CLOCKSOURCE_SMCLK                              0x80
+#define EUSCI_A_UART_CLOCKSOURCE_ACLK                               0x40
+#define EUSCI_A_UART_ONE_STOP_BIT                                   0x00
+#define EUSCI_A_UART_TWO_STOP_BITS                                  0x0800
+#define EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION               0x01
+#define EUSCI_A_UART_LOW_FREQUENCY_BAUDRATE_GENERATION              0x00
+#define EUSCI_A_UART_8_BIT_LEN                                      0x00
+#define EUSCI_A_UART_7_BIT_LEN                                      0x1000
+
+#define EUSCI_A_UART_RECEIVE_INTERRUPT                              0x0001
+#define EUSCI_A_UART_TRANSMIT_INTERRUPT                             0x0002
+#define EUSCI_A_UART_STARTBIT_INTERRUPT                             0x0004
+#define EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT                    0x0008
+#define EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG                         0x0001
+#define EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG                        0x0002
+#define EUSCI_A_UART_STARTBIT_INTERRUPT_FLAG                        0x0004
+#define EUSCI_A_UART_TRANSMIT_COMPLETE_INTERRUPT_FLAG               0x0008
+
+typedef struct _eUSCI_eUSCI_UART_ConfigV1
+{
+    uint_fast8_t selectClockSource;
+    uint_fast16_t clockPrescalar;
+    uint_fast8_t firstModReg;
+    uint_fast8_t secondModReg;
+    uint_fast8_t parity;
+    uint_fast16_t msborLsbFirst;
+    uint_fast16_t numberofStopBits;
+    uint_fast16_t uartMode;
+    uint_fast8_t overSampling;
+    uint_fast16_t dataLength;
+} eUSCI_UART_ConfigV1;
+
+extern bool UART_initModule(uint32_t moduleInstance,
+                            const eUSCI_UART_ConfigV1 *config);
+extern void UART_enableModule(uint32_t moduleInstance);
+extern void UART_disableModule(uint32_t moduleInstance);
+extern void UART_transmitData(uint32_t moduleInstance,
+                              uint_fast8_t transmitData);
+extern void UART_enableInterrupt(uint32_t moduleInstance, uint_fast8_t mask);
+extern void UART_disableInterrupt(uint32_t moduleInstance, uint_fast8_t mask);
+extern uint_fast8_t UART_getInterruptStatus(uint32_t moduleInstance,
+                                            uint8_t mask);
+extern uint_fast8_t UART_getEnabledInterruptStatus(uint32_t moduleInstance);
+extern void UART_clearInterruptFlag(uint32_t moduleInstance,
+                                    uint_fast8_t mask);
+
+/* ------------------------------------------------------------------------- CS */
+
+#define CS_ACLK                                                     0x01
+#define CS_MCLK                                                     0x02
+#define CS_SMCLK                                                    0x04
+#define CS_HSMCLK                                                   0x08
+#define CS_BCLK                                                     0x10
+
+#define CS_LFXTCLK_SELECT                                           0x00
+#define CS_VLOCLK_SELECT                                            0x01
+#define CS_REFOCLK_SELECT                                           0x02
+#define CS_DCOCLK_SELECT                                            0x03
+#define CS_MODOSC_SELECT                                            0x04
+#define CS_HFXTCLK_SELECT                                           0x05
+
+#define CS_CLOCK_DIVIDER_1                                          0x00000000
+#define CS_CLOCK_DIVIDER_2                                          0x10000000
+#define CS_CLOCK_DIVIDER_4                                          0x20000000
+#define CS_CLOCK_DIVIDER_8                                          0x30000000
+#define CS_CLOCK_DIVIDER_16                                         0x40000000
+#define CS_CLOCK_DIVIDER_32                                         0x50000000
+#define CS_CLOCK_DIVIDER_64                                         0x60000000
+#define CS_CLOCK_DIVIDER_128                                        0x70000000
+
+#define CS_REFO_32KHZ                                               0x00
+#define CS_REFO_128KHZ                                              0x01
+
+#define CS_DCO_FREQUENCY_1_5                                        0x00000000
+#define CS_DCO_FREQUENCY_3                                          0x00010000
+#define CS_DCO_FREQUENCY_6                                          0x00020000
+#define CS_DCO_FREQUENCY_12                                         0x00030000
+#define CS_DCO_FREQUENCY_24                                         0x00040000
+#define CS_DCO_FREQUENCY_48                                         0x00050000
+
+extern void CS_setReferenceOscillatorFrequency(uint8_t referenceFrequency);
+extern void CS_initClockSignal(uint32_t selectedClockSignal,
+                               uint32_t clockSource, uint32_t clockSourceDivider);
+extern void CS_setDCOCenteredFrequency(uint32_t dcoFreq);
+extern uint32_t CS_getMCLK(void);
+extern uint32_t CS_getSMCLK(void);
+extern uint32_t CS_getHSMCLK(void);
+extern uint32_t CS_getACLK(void);
+
+/* --------------------------------------- PCM, FlashCtl, WDT_A, PMAP and FPU */
+
+#define PCM_VCORE0                                                  0x00
+#define PCM_VCORE1                                                  0x01
+#define PCM_AM_LDO_VCORE0                                           0x00
+#define PCM_AM_LDO_VCORE1                                           0x01
+
+#define FLASH_BANK0                                                 0x00
+#define FLASH_BANK1                                                 0x01
+
+#define PMAP_NONE                                                   0
+#define PMAP_TA0CCR0A                                               19
+#define PMAP_TA0CCR1A                                               20
+#define PMAP_TA0CCR2A                                               21
+#define PMAP_TA0CCR3A                                               22
+#define PMAP_TA0CCR4A                                               23
+#define PMAP_TA1CCR1A                                               24
+#define PMAP_TA1CCR2A                                               25
+#define PMAP_TA1CCR3A                                               26
+#define PMAP_TA1CCR4A                                               27
+#define PMAP_P1MAP                                                  0x00
+#define PMAP_P2MAP                                                  0x08
+#define PMAP_P3MAP                                                  0x10
+#define PMAP_P7MAP                                                  0x38
+#define PMAP_ENABLE_RECONFIGURATION                                 0x02
+#define PMAP_DISABLE_RECONFIGURATION                                0x00
+
+extern bool PCM_gotoLPM0(void);
+extern bool PCM_gotoLPM3(void);
+extern bool PCM_setCoreVoltageLevel(uint_fast8_t voltageLevel);
+extern uint8_t PCM_getCoreVoltageLevel(void);
+
+extern void FlashCtl_setWaitState(uint32_t bank, uint32_t waitState);
+
+extern void WDT_A_holdTimer(void);
+
+extern void PMAP_configurePorts(const uint8_t *portMapping, uint8_t pxMAPy,
+                                uint8_t numberOfPorts,
+                                uint8_t portMapReconfigure);
+
+extern void FPU_enableModule(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_DRIVERLIB_H_ */
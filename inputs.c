@@ -8,26 +8,228 @@
  *      Author: Cooper Brotherton and Jesus Capo
  */
 #include <inputs.h>
+#include <Timebase.h>
+#include <Tick.h>
+#include <Power.h>
+#include <Sensor.h>
+#include <outputs.h>
+#include <HAL.h>
+#include <Probe.h>
+#include <Telemetry.h>
+#include <Trace.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+#define KEY_NONE                                                    -1
+#define KEYPAD_SCAN_MS                                              2
+// Scans a key must stay the same for before its event is queued
+#define KEYPAD_DEBOUNCE_SCANS                                       3
+// Must be a power of two
+#define KEYPAD_QUEUE_SIZE                                           16
+
+/* Lock-free single producer (scanner) single consumer (task) event queue */
+static KeypadEvent keypadQueue[KEYPAD_QUEUE_SIZE];
+static volatile uint8_t keypadHead = 0;
+static volatile uint8_t keypadTail = 0;
+
+/* Scanner debounce state */
+static int debouncedKey = KEY_NONE;
+static int candidateKey = KEY_NONE;
+static int candidateScans = 0;
+static uint32_t candidateTime = 0;
+static TickTimer keypadTimer;
+
+#define SWITCH_DEBOUNCE_MS                                          10
+// Must be a power of two
+#define SWITCH_QUEUE_SIZE                                           16
+
+/* Lock-free single producer (debouncer) single consumer event queue */
+static SwitchEvent switchQueue[SWITCH_QUEUE_SIZE];
+static volatile uint8_t switchHead = 0;
+static volatile uint8_t switchTail = 0;
+
+/* Debounced P1 switch state, a set bit means that switch is pressed */
+static volatile uint8_t switchState = 0;
+/* Switches waiting on the debounce timer and the time of their first edge */
+static volatile uint8_t switchPending = 0;
+static uint32_t switchEdgeTime[8];
+static TickTimer switchTimer;
+
+#define ADC_MAX_BLOCK_SIZE            (ADC_FRAMES_PER_BLOCK * NUM_OF_SENSORS)
+
+typedef struct _ADC_ChannelConfig
+{
+    uint32_t input;
+    uint32_t resolution;
+    uint8_t bits;
+    uint32_t trigger;       // TA1.1 every servo period, TA1.2 every other
+    int window;             // Comparator window, -1 if none
+} ADC_ChannelConfig;
+
+/* The pot needs every count, the thresholds don't */
+static const ADC_ChannelConfig adcChannels[NUM_OF_SENSORS] = {
+        { ADC_INPUT_A3, ADC_14BIT, 14, ADC_TRIGGER_SOURCE3, -1 },
+        { ADC_INPUT_A4, ADC_10BIT, 10, ADC_TRIGGER_SOURCE4, 1 },
+        { ADC_INPUT_A5, ADC_10BIT, 10, ADC_TRIGGER_SOURCE4, 0 } };
+
+/* Channels in the running sequence, in conversion order */
+static uint8_t adcSelected = 0;
+static int adcOrder[NUM_OF_SENSORS];
+static int adcOrderLength = 0;
+static int adcBlockSize = 0;
+/* Shift that scales each channel's samples up to 14 bits */
+static uint8_t adcShift = 0;
+
+/* Ping-pong halves the uDMA copies each ADC sequence into */
+static uint16_t adcBlocks[2][ADC_MAX_BLOCK_SIZE];
+/* Per-channel rings of 14-bit samples and the number written to each */
+static uint16_t adcRings[NUM_OF_SENSORS][ADC_RING_SIZE];
+static volatile uint32_t adcCounts[NUM_OF_SENSORS];
+/* Channel whose window is armed, -1 if none, see ADC_armWindow */
+static volatile int adcWindowChannel = -1;
+/* Set per channel by the window comparator interrupt */
+static volatile bool adcWindowCrossed[NUM_OF_SENSORS];
+
+/*!
+ * \brief This function enables the edge interrupts of the given switches
+ *
+ * This function selects the edge that leaves the current debounced state of
+ * each switch: rising for a pressed switch, falling for a released one.
+ *
+ * \param pins is the mask of switch pins to arm
+ *
+ * \return None
+ */
+void Switch_armEdges(uint8_t pins)
+{
+    GPIO_interruptEdgeSelect(SWITCH_PORT, pins & switchState,
+                             GPIO_LOW_TO_HIGH_TRANSITION);
+    GPIO_interruptEdgeSelect(SWITCH_PORT, pins & ~switchState,
+                             GPIO_HIGH_TO_LOW_TRANSITION);
+    // Changing the edge select can set the flag, clear it afterwards
+    GPIO_clearInterruptFlag(SWITCH_PORT, pins);
+    GPIO_enableInterrupt(SWITCH_PORT, pins);
+}
+
+/*!
+ * \brief This function starts debouncing the given switches
+ *
+ * This function disables the edge interrupts of the switches, records when
+ * they first moved, and (re)starts the debounce timer.
+ *
+ * \param pins is the mask of switch pins that moved
+ *
+ * \return None
+ */
+void Switch_startDebounce(uint8_t pins)
+{
+    GPIO_disableInterrupt(SWITCH_PORT, pins);
+    GPIO_clearInterruptFlag(SWITCH_PORT, pins);
+    uint32_t now = Timebase_now();
+    int pin;
+    for (pin = 0; pin < 8; pin++)
+    {
+        if ((pins & (1 << pin)) && !(switchPending & (1 << pin)))
+        {
+            switchEdgeTime[pin] = now;
+        }
+    }
+    switchPending |= pins;
+    Tick_start(&switchTimer, SWITCH_DEBOUNCE_MS, 0, Switch_debounce);
+}
+
+/*!
+ * \brief This function adds an event to the switch queue
+ *
+ * Called only from the debouncer. The event is dropped if the queue is full.
+ *
+ * \return None
+ */
+void switch_push(int pin, bool pressed, uint32_t timestamp)
+{
+    uint8_t head = switchHead;
+    uint8_t next = (head + 1) & (SWITCH_QUEUE_SIZE - 1);
+    if (next == switchTail)
+    {
+        return;
+    }
+    switchQueue[head].pin = pin;
+    switchQueue[head].pressed = pressed;
+    switchQueue[head].timestamp = timestamp;
+    // Publish only after the event is written
+    switchHead = next;
+    Trace_record(TRACE_SWITCH, 2 * pin + pressed);
+    Power_wake(WAKE_SWITCHES);
+}
+
+void Switch_debounce(void)
+{
+    uint8_t pending = switchPending;
+    // Pull-ups make a pressed switch read low
+    uint8_t pressed = ~HAL_readPort(SWITCH_PORT) & pending;
+    uint8_t changed = (pressed ^ switchState) & pending;
+    int pin;
+    for (pin = 0; pin < 8; pin++)
+    {
+        if (changed & (1 << pin))
+        {
+            switch_push(pin, pressed & (1 << pin), switchEdgeTime[pin]);
+        }
+    }
+    switchState = (switchState & ~pending) | pressed;
+    switchPending = 0;
+    Switch_armEdges(pending);
+
+    // A switch that moved again while it was being re-armed
+    uint8_t moved = (~HAL_readPort(SWITCH_PORT) ^ switchState) & pending;
+    if (moved)
+    {
+        Switch_startDebounce(moved);
+    }
+}
+
 /*!
  * \brief This function configures the switches as inputs
  *
  * This function configures P1.1, P1.4, and P1.5 as input pins with pull-up
- * resistors.
+ * resistors and edge interrupts.
  *
  * \return None
  */
 void Switch_init(void)
 {
     GPIO_setAsInputPinWithPullUpResistor(SWITCH_PORT, SWITCH_PINS);
+    switchState = ~HAL_readPort(SWITCH_PORT) & SWITCH_PINS;
+    Switch_armEdges(SWITCH_PINS);
+    Interrupt_enableInterrupt(INT_PORT1);
+}
+
+/*!
+ * \brief This function waits for any key to be pressed
+ *
+ * This function drives every row low so any key pulls its column low, and
+ * enables the falling edge interrupts on the columns. The scanner is started
+ * directly if a key is already down.
+ *
+ * \return None
+ */
+void keypad_armEdges(void)
+{
+    GPIO_setOutputLowOnPin(KEYPAD_PORT, KEYPAD_OUTPUT_PINS);
+    GPIO_clearInterruptFlag(KEYPAD_PORT, KEYPAD_INPUT_PINS);
+    GPIO_enableInterrupt(KEYPAD_PORT, KEYPAD_INPUT_PINS);
+    // Catch a press that happened between the last scan and re-arming
+    if ((HAL_readPort(KEYPAD_PORT) & KEYPAD_INPUT_PINS) != KEYPAD_INPUT_PINS)
+    {
+        GPIO_disableInterrupt(KEYPAD_PORT, KEYPAD_INPUT_PINS);
+        Tick_start(&keypadTimer, KEYPAD_SCAN_MS, KEYPAD_SCAN_MS, keypad_scan);
+    }
 }
 
 /*!
  * \brief This function configures port P4 for keypad I/O
  *
- * This function initializes P4.0-4.3 as input pins with a pull-up resistor and
- * P4.4-4.7 as output pins.
+ * This function initializes P4.4-4.7 as input pins with a pull-up resistor and
+ * falling edge interrupts, and P4.0-4.3 as output pins.
  *
  * \return None
  */
@@ -35,52 +237,291 @@ void Keypad_init(void)
 {
     GPIO_setAsInputPinWithPullUpResistor(KEYPAD_PORT, KEYPAD_INPUT_PINS);
     GPIO_setAsOutputPin(KEYPAD_PORT, KEYPAD_OUTPUT_PINS);
-    GPIO_setOutputHighOnPin(KEYPAD_PORT, KEYPAD_OUTPUT_PINS);
+    GPIO_interruptEdgeSelect(KEYPAD_PORT, KEYPAD_INPUT_PINS,
+                             GPIO_HIGH_TO_LOW_TRANSITION);
+    keypad_armEdges();
+    Interrupt_enableInterrupt(INT_PORT4);
+}
+
+/*!
+ * \brief This function points a DMA structure at the next ADC block
+ *
+ * \param select is UDMA_PRI_SELECT or UDMA_ALT_SELECT
+ * \param block is the half of the DMA buffer to fill
+ *
+ * \return None
+ */
+void ADC_armBlock(uint32_t select, uint16_t *block)
+{
+    DMA_setChannelControl(select | DMA_CH7_ADC14,
+    UDMA_SIZE_16 | UDMA_SRC_INC_32 | UDMA_DST_INC_16 | UDMA_ARB_8);
+    DMA_setChannelTransfer(select | DMA_CH7_ADC14, UDMA_MODE_PINGPONG,
+                           (void*) HAL_getADCResultAddress(0), block,
+                           adcBlockSize);
+}
+
+/*!
+ * \brief This function stops the ADC14 sequence and its DMA channel
+ *
+ * A repeat sequence only stops at its end when ENC is cleared, so CONSEQ is
+ * cleared along with it to stop right away. The partial block is dropped.
+ *
+ * \return None
+ */
+void ADC_stop(void)
+{
+    HAL_stopADCSequence();
+    while (ADC14_isBusy())
+    {
+    }
+    DMA_disableChannel(7);
+    DMA_clearInterruptFlag(7);
+    Interrupt_unpendInterrupt(INT_DMA_INT1);
+    ADC14_disableInterrupt(ADC_HI_INT | ADC_LO_INT);
+    ADC14_clearInterruptFlag(0xFFFFFFFFFFFFFFFF);
+    Interrupt_unpendInterrupt(INT_ADC14);
+}
+
+/*!
+ * \brief This function converts one sample of a channel right away
+ *
+ * This function is used when a channel is selected so its snapshot is fresh
+ * before the first triggered sample arrives. The ADC must be stopped.
+ *
+ * \param channel is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return the sample scaled to 14 bits
+ */
+uint16_t ADC_convertNow(int channel)
+{
+    const ADC_ChannelConfig *config = &adcChannels[channel];
+    ADC14_setResolution(config->resolution);
+    ADC14_configureSingleSampleMode(ADC_MEM0, false);
+    ADC14_configureConversionMemory(ADC_MEM0, ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                    config->input, false);
+    ADC14_setSampleHoldTrigger(ADC_TRIGGER_ADSC, false);
+    ADC14_enableConversion();
+    ADC14_toggleConversionTrigger();
+    while (!(ADC14_getInterruptStatus() & ADC_INT0))
+    {
+    }
+    uint16_t sample = ADC14_getResult(ADC_MEM0) << (14 - config->bits);
+    ADC14_disableConversion();
+    return sample;
 }
 
 /*!
  * \brief This function initializes the ADC14
  *
- * This function initializes the ADC14 module in 14-bit mode using A3-A5 with
- * interrupts. It also sets P5.0-5.2 as analog inputs.
+ * This function initializes the ADC14 and its DMA channel and sets P5.0-5.2
+ * as analog inputs. Nothing is converted and the ADC14 is left off until
+ * ADC_selectChannels is called. DMAControl_init must be called first.
  *
  * \return None
  */
 void ADC_init(void)
 {
-    // Enabling the FPU for floating point operation
-    FPU_enableModule();
-    FPU_enableLazyStacking();
-
     // Initializing ADC
     ADC14_enableModule();
-    ADC14_initModule(ADC_CLOCKSOURCE_MCLK, ADC_PREDIVIDER_1, ADC_DIVIDER_1, 0);
+    // SMCLK stays at 3 MHz in every clock profile, MCLK can be too fast
+    ADC14_initModule(ADC_CLOCKSOURCE_SMCLK, ADC_PREDIVIDER_1, ADC_DIVIDER_1, 0);
+    ADC14_enableSampleTimer(ADC_MANUAL_ITERATION);
+    ADC14_setComparatorWindowValue(ADC_COMP_WINDOW0, 0, ADC_WINDOW_MAX);
+    ADC14_setComparatorWindowValue(ADC_COMP_WINDOW1, 0, ADC_WINDOW_MAX);
+    ADC14_disableModule();
 
     // Configuring GPIOs (5.0, 5.1, 5.2; A5, A4, A3)
     GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P5,
     GPIO_PIN0 | GPIO_PIN1 | GPIO_PIN2,
                                                GPIO_TERTIARY_MODULE_FUNCTION);
 
-    // Configuring ADC
-    ADC14_configureMultiSequenceMode(ADC_MEM3, ADC_MEM5, true);
-    ADC14_configureConversionMemory(ADC_MEM3,
-    ADC_VREFPOS_AVCC_VREFNEG_VSS,
-                                    ADC_INPUT_A3, false);
-    ADC14_configureConversionMemory(ADC_MEM4,
-    ADC_VREFPOS_AVCC_VREFNEG_VSS,
-                                    ADC_INPUT_A4, false);
-    ADC14_configureConversionMemory(ADC_MEM5,
-    ADC_VREFPOS_AVCC_VREFNEG_VSS,
-                                    ADC_INPUT_A5, false);
-    ADC14_enableSampleTimer(ADC_MANUAL_ITERATION);
-    ADC14_setResolution(ADC_14BIT);
-    ADC14_enableConversion();
-    ADC14_enableInterrupt(ADC_INT3);
-    ADC14_enableInterrupt(ADC_INT4);
-    ADC14_enableInterrupt(ADC_INT5);
+    // TA1.2 toggles once per servo period, so its rising edge comes every
+    // other period and triggers the slow channels
+    const Timer_A_CompareModeConfig slowTrigger = {
+            TIMER_A_CAPTURECOMPARE_REGISTER_2,
+            TIMER_A_CAPTURECOMPARE_INTERRUPT_DISABLE,
+            TIMER_A_OUTPUTMODE_TOGGLE,
+            SERVO_PERIOD / 2 };
+    Timer_A_initCompare(TIMER_A1_BASE, &slowTrigger);
+
+    Sensor_init();
+
+    DMA_assignChannel(DMA_CH7_ADC14);
+    DMA_disableChannelAttribute(DMA_CH7_ADC14,
+    UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY |
+    UDMA_ATTR_REQMASK);
+    DMA_assignInterrupt(DMA_INT1, 7);
+    DMA_enableInterrupt(INT_DMA_INT1);
+    Interrupt_enableInterrupt(INT_DMA_INT1);
     Interrupt_enableInterrupt(INT_ADC14);
 }
 
+void ADC_selectChannels(uint8_t channels)
+{
+    bool wasDisabled = Interrupt_disableMaster();
+    if (adcSelected)
+    {
+        ADC_stop();
+    }
+    adcSelected = channels;
+    adcOrderLength = 0;
+    if (!channels)
+    {
+        // Nothing to convert, leave the ADC14 powered down
+        ADC14_disableModule();
+        if (!wasDisabled)
+        {
+            Interrupt_enableMaster();
+        }
+        return;
+    }
+
+    ADC14_enableModule();
+    // The sequence runs at the highest resolution and fastest trigger of the
+    // selected channels
+    uint8_t bits = 0;
+    uint32_t resolution = ADC_8BIT;
+    uint32_t trigger = ADC_TRIGGER_SOURCE4;
+    int channel;
+    for (channel = 0; channel < NUM_OF_SENSORS; channel++)
+    {
+        if (!(channels & ADC_CHANNEL(channel)))
+        {
+            continue;
+        }
+        const ADC_ChannelConfig *config = &adcChannels[channel];
+        adcOrder[adcOrderLength++] = channel;
+        Sensor_restart(channel);
+        Sensor_publish(channel, ADC_convertNow(channel), Timebase_now());
+        if (config->bits > bits)
+        {
+            bits = config->bits;
+            resolution = config->resolution;
+        }
+        if (config->trigger == ADC_TRIGGER_SOURCE3)
+        {
+            trigger = ADC_TRIGGER_SOURCE3;
+        }
+    }
+    adcShift = 14 - bits;
+    ADC14_setResolution(resolution);
+    // Ultra-low-power mode only allows up to 12 bits
+    ADC14_setPowerMode(
+            bits > 12 ? ADC_UNRESTRICTED_POWER_MODE : ADC_ULTRA_LOW_POWER_MODE);
+
+    // Memory n converts the (n % length)th selected channel
+    adcBlockSize = ADC_FRAMES_PER_BLOCK * adcOrderLength;
+    ADC14_configureMultiSequenceMode(ADC_MEM0,
+                                     ADC_MEM0 << (adcBlockSize - 1), true);
+    ADC14_disableComparatorWindow(0xFFFFFFFF);
+    int mem;
+    for (mem = 0; mem < adcBlockSize; mem++)
+    {
+        const ADC_ChannelConfig *config =
+                &adcChannels[adcOrder[mem % adcOrderLength]];
+        ADC14_configureConversionMemory(ADC_MEM0 << mem,
+        ADC_VREFPOS_AVCC_VREFNEG_VSS,
+                                        config->input, false);
+        if (config->window >= 0)
+        {
+            ADC14_enableComparatorWindow(
+                    ADC_MEM0 << mem,
+                    config->window ? ADC_COMP_WINDOW1 : ADC_COMP_WINDOW0);
+        }
+    }
+    // One conversion per trigger edge
+    ADC14_setSampleHoldTrigger(trigger, false);
+
+    // Ping-pong between the two halves of the DMA buffer
+    DMA_disableChannelAttribute(DMA_CH7_ADC14, UDMA_ATTR_ALTSELECT);
+    ADC_armBlock(UDMA_PRI_SELECT, adcBlocks[0]);
+    ADC_armBlock(UDMA_ALT_SELECT, adcBlocks[1]);
+    DMA_enableChannel(7);
+
+    ADC14_enableConversion();
+    if (!wasDisabled)
+    {
+        Interrupt_enableMaster();
+    }
+}
+
+/*!
+ * \brief This function sets the thresholds of a sensor's comparator window
+ *
+ * DriverLib refuses to change the thresholds while a sequence is running,
+ * which is always, so the registers are written through the HAL. They take
+ * effect from the next conversion.
+ *
+ * \param channel is SENSOR_THERM or SENSOR_PHOTO
+ * \param low is the lower threshold at the sequence's resolution
+ * \param high is the upper threshold at the sequence's resolution
+ *
+ * \return None
+ */
+void ADC_setWindow(int channel, uint16_t low, uint16_t high)
+{
+    const int window = adcChannels[channel].window;
+    if (window >= 0)
+    {
+        HAL_setADCWindow(window ? ADC_COMP_WINDOW1 : ADC_COMP_WINDOW0, low,
+                         high);
+    }
+}
+
+void ADC_armWindow(int channel, uint16_t low, uint16_t high)
+{
+    ADC14_disableInterrupt(ADC_HI_INT | ADC_LO_INT);
+    adcWindowCrossed[channel] = false;
+    adcWindowChannel = channel;
+    // Round the window outwards so a crossing means the 14-bit target is met
+    ADC_setWindow(channel, low >> adcShift,
+                  (high + (1 << adcShift) - 1) >> adcShift);
+    ADC14_clearInterruptFlag(ADC_HI_INT | ADC_LO_INT);
+    ADC14_enableInterrupt(ADC_HI_INT | ADC_LO_INT);
+}
+
+void ADC_disarmWindow(int channel)
+{
+    ADC14_disableInterrupt(ADC_HI_INT | ADC_LO_INT);
+    ADC_setWindow(channel, 0, ADC_WINDOW_MAX);
+    adcWindowCrossed[channel] = false;
+    if (adcWindowChannel == channel)
+    {
+        adcWindowChannel = -1;
+    }
+}
+
+bool ADC_windowCrossed(int channel)
+{
+    return adcWindowCrossed[channel];
+}
+
+uint32_t ADC_sampleCount(int channel)
+{
+    return adcCounts[channel];
+}
+
+int ADC_readRing(int channel, uint16_t *samples, int count)
+{
+    uint32_t written = adcCounts[channel];
+    if (count > ADC_RING_SIZE - ADC_FRAMES_PER_BLOCK)
+    {
+        // The newest block may be written over while copying
+        count = ADC_RING_SIZE - ADC_FRAMES_PER_BLOCK;
+    }
+    if ((uint32_t) count > written)
+    {
+        count = written;
+    }
+    int i;
+    for (i = 0; i < count; i++)
+    {
+        samples[i] = adcRings[channel][(written - count + i)
+                & (ADC_RING_SIZE - 1)];
+    }
+    return count;
+}
+
 void inputs_init(void)
 {
     Switch_init();
@@ -90,41 +531,298 @@ void inputs_init(void)
 
 bool switch_pressed(int pin)
 {
-    return GPIO_getInputPinValue(SWITCH_PORT, 1 << pin) == GPIO_INPUT_PIN_HIGH ?
-            false : true;
+    return (switchState & (1 << pin)) != 0;
 }
 
-char keypad_get_input(void)
+bool switch_poll(SwitchEvent *event)
+{
+    uint8_t tail = switchTail;
+    if (tail == switchHead)
+    {
+        return false;
+    }
+    *event = switchQueue[tail];
+    switchTail = (tail + 1) & (SWITCH_QUEUE_SIZE - 1);
+    return true;
+}
+
+bool switch_read(SwitchEvent *event, uint32_t timeout)
+{
+    const uint64_t start = Tick_now();
+    while (!switch_poll(event))
+    {
+        if (timeout == SWITCH_WAIT_FOREVER)
+        {
+            Power_sleep(WAKE_SWITCHES);
+            continue;
+        }
+        uint64_t elapsed = Tick_now() - start;
+        if (elapsed >= timeout)
+        {
+            return false;
+        }
+        Power_sleepFor(WAKE_SWITCHES, timeout - elapsed);
+    }
+    return true;
+}
+
+/*!
+ * \brief This function reads which key is down
+ *
+ * This function drives one row low at a time and checks the columns. If more
+ * than one key is down, the first one found is reported.
+ *
+ * \return the key index (row * 4 + column), or KEY_NONE
+ */
+int keypad_readRaw(void)
 {
-    int key_out;
     int row;
-    while (1)
+    int key = KEY_NONE;
+    for (row = 0; row < 4 && key == KEY_NONE; row++)
+    {
+        GPIO_setOutputHighOnPin(KEYPAD_PORT, KEYPAD_OUTPUT_PINS);
+        GPIO_setOutputLowOnPin(KEYPAD_PORT, 1 << row);
+
+        int key_out = (HAL_readPort(KEYPAD_PORT) & KEYPAD_INPUT_PINS) >> 4;
+        switch (key_out)
+        {
+        case 0b0111:
+            key = row * 4 + 0;
+            break;
+        case 0b1011:
+            key = row * 4 + 1;
+            break;
+        case 0b1101:
+            key = row * 4 + 2;
+            break;
+        case 0b1110:
+            key = row * 4 + 3;
+            break;
+        }
+    }
+    return key;
+}
+
+/*!
+ * \brief This function adds an event to the keypad queue
+ *
+ * Called only from the scanner. The event is dropped if the queue is full.
+ *
+ * \return None
+ */
+void keypad_push(int key, bool pressed, uint32_t timestamp)
+{
+    uint8_t head = keypadHead;
+    uint8_t next = (head + 1) & (KEYPAD_QUEUE_SIZE - 1);
+    if (next == keypadTail)
+    {
+        return;
+    }
+    keypadQueue[head].key = keypad_map[key / 4][key % 4];
+    keypadQueue[head].pressed = pressed;
+    keypadQueue[head].timestamp = timestamp;
+    // Publish only after the event is written
+    keypadHead = next;
+    Trace_record(TRACE_KEY, keypadQueue[head].key + (pressed ? 256 : 0));
+    Power_wake(WAKE_KEYPAD);
+}
+
+void keypad_scan(void)
+{
+    PROBE_BEGIN(probe);
+    int key = keypad_readRaw();
+    if (key != candidateKey)
+    {
+        candidateKey = key;
+        candidateScans = 1;
+        candidateTime = Timebase_now();
+    }
+    else if (candidateScans < KEYPAD_DEBOUNCE_SCANS)
+    {
+        candidateScans++;
+    }
+
+    if (candidateScans == KEYPAD_DEBOUNCE_SCANS && candidateKey != debouncedKey)
+    {
+        if (debouncedKey != KEY_NONE)
+        {
+            keypad_push(debouncedKey, false, candidateTime);
+        }
+        if (candidateKey != KEY_NONE)
+        {
+            keypad_push(candidateKey, true, candidateTime);
+        }
+        debouncedKey = candidateKey;
+    }
+
+    if (debouncedKey == KEY_NONE && candidateKey == KEY_NONE
+            && candidateScans == KEYPAD_DEBOUNCE_SCANS)
+    {
+        // All keys released, sleep until the next column edge
+        Tick_cancel(&keypadTimer);
+        keypad_armEdges();
+    }
+    PROBE_END(probe, PROBE_KEYPAD_SCAN);
+}
+
+bool keypad_poll(KeypadEvent *event)
+{
+    uint8_t tail = keypadTail;
+    if (tail == keypadHead)
     {
-        for (row = 0; row < 4; row++)
+        return false;
+    }
+    *event = keypadQueue[tail];
+    keypadTail = (tail + 1) & (KEYPAD_QUEUE_SIZE - 1);
+    return true;
+}
+
+bool keypad_read(KeypadEvent *event, uint32_t timeout)
+{
+    const uint64_t start = Tick_now();
+    while (!keypad_poll(event))
+    {
+        if (timeout == KEYPAD_WAIT_FOREVER)
         {
-            GPIO_setOutputHighOnPin(KEYPAD_PORT, KEYPAD_OUTPUT_PINS);
-            GPIO_setOutputLowOnPin(KEYPAD_PORT, 1 << row);
+            Power_sleep(WAKE_KEYPAD);
+            continue;
+        }
+        uint64_t elapsed = Tick_now() - start;
+        if (elapsed >= timeout)
+        {
+            return false;
+        }
+        Power_sleepFor(WAKE_KEYPAD, timeout - elapsed);
+    }
+    return true;
+}
+
+char keypad_get_input(void)
+{
+    KeypadEvent event;
+    do
+    {
+        keypad_read(&event, KEYPAD_WAIT_FOREVER);
+    }
+    while (!event.pressed);
+    return event.key;
+}
+
+/*!
+ * \brief This function handles the interrupt of port P4
+ *
+ * This function starts the keypad scanner on the first column edge. The edge
+ * interrupts stay off until every key has been released again.
+ *
+ * \return None
+ */
+void PORT4_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    uint32_t status = GPIO_getEnabledInterruptStatus(KEYPAD_PORT);
+    GPIO_clearInterruptFlag(KEYPAD_PORT, status);
+    if (status & KEYPAD_INPUT_PINS)
+    {
+        GPIO_disableInterrupt(KEYPAD_PORT, KEYPAD_INPUT_PINS);
+        Tick_start(&keypadTimer, KEYPAD_SCAN_MS, KEYPAD_SCAN_MS, keypad_scan);
+    }
+    PROBE_END(probe, PROBE_PORT4);
+}
 
-            key_out = (P4->IN & 0b11110000) >> 4;
-            if (key_out != 0b1111)
+/*!
+ * \brief This function handles the interrupt of port P1
+ *
+ * This function starts debouncing the switches that saw an edge. Their edge
+ * interrupts stay off until the debounce timer has sampled them.
+ *
+ * \return None
+ */
+void PORT1_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    uint32_t status = GPIO_getEnabledInterruptStatus(SWITCH_PORT);
+    GPIO_clearInterruptFlag(SWITCH_PORT, status);
+    if (status & SWITCH_PINS)
+    {
+        Switch_startDebounce(status & SWITCH_PINS);
+    }
+    PROBE_END(probe, PROBE_PORT1);
+}
+
+/*!
+ * \brief This function handles the DMA_INT1 interrupt
+ *
+ * This function runs once per ADC block, when one half of the ping-pong buffer
+ * is full. It rearms that half, splits the block into the per-channel rings,
+ * publishes each sample to its sensor snapshot, logs the latest sample of each
+ * sensor to the telemetry channel and wakes anything waiting on WAKE_ADC.
+ *
+ * \return None
+ */
+void DMA_INT1_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    uint16_t *block;
+    DMA_clearInterruptFlag(7);
+    // The controller has moved on to the other structure
+    if (DMA_getChannelAttribute(7) & UDMA_ATTR_ALTSELECT)
+    {
+        block = adcBlocks[0];
+        ADC_armBlock(UDMA_PRI_SELECT, block);
+    }
+    else
+    {
+        block = adcBlocks[1];
+        ADC_armBlock(UDMA_ALT_SELECT, block);
+    }
+
+    uint32_t now = Timebase_now();
+    int frame, i;
+    for (frame = 0; frame < ADC_FRAMES_PER_BLOCK; frame++)
+    {
+        for (i = 0; i < adcOrderLength; i++)
+        {
+            int channel = adcOrder[i];
+            uint16_t sample = block[frame * adcOrderLength + i] << adcShift;
+            uint32_t written = adcCounts[channel];
+            adcRings[channel][written & (ADC_RING_SIZE - 1)] = sample;
+            // Publish only after the sample is written
+            adcCounts[channel] = written + 1;
+            Sensor_publish(channel, sample, now);
+            if (frame == ADC_FRAMES_PER_BLOCK - 1)
             {
-                while ((P4->IN & 0b11110000) >> 4 != 0b1111)
-                    ;
-                switch (key_out)
-                {
-                case 0b0111:
-                    return keypad_map[row][0];
-                case 0b1011:
-                    return keypad_map[row][1];
-                case 0b1101:
-                    return keypad_map[row][2];
-                case 0b1110:
-                    return keypad_map[row][3];
-                default:
-                    return ' ';
-                }
+                Telemetry_log(TELEMETRY_SENSOR_POT + channel, sample);
             }
         }
+    }
+    Power_wake(WAKE_ADC);
+    PROBE_END(probe, PROBE_DMA_INT1);
+}
 
+/*!
+ * \brief This function handles the ADC14 interrupt
+ *
+ * Only the window comparator interrupts are enabled. They fire on every
+ * conversion outside the window, so they are disabled after the first one
+ * until ADC_armWindow is called again. Both windows share the interrupt
+ * flags, so the crossing is set for the channel that was armed.
+ *
+ * \return None
+ */
+void ADC14_IRQHandler(void)
+{
+    PROBE_BEGIN(probe);
+    uint64_t status = ADC14_getEnabledInterruptStatus();
+    ADC14_clearInterruptFlag(status);
+    if (status & (ADC_HI_INT | ADC_LO_INT))
+    {
+        ADC14_disableInterrupt(ADC_HI_INT | ADC_LO_INT);
+        if (adcWindowChannel >= 0)
+        {
+            adcWindowCrossed[adcWindowChannel] = true;
+        }
+        Trace_record(TRACE_WINDOW, (status & ADC_HI_INT) != 0);
+        Power_wake(WAKE_ADC);
     }
+    PROBE_END(probe, PROBE_ADC14);
 }
@@ -25,6 +25,32 @@ extern "C" {
 #define KEYPAD_INPUT_PINS                                           0x00F0
 #define KEYPAD_OUTPUT_PINS                                          0x000F
 
+// Frames converted per DMA block, each frame is one sample of every channel
+#define ADC_FRAMES_PER_BLOCK                                        2
+// Must be a power of two
+#define ADC_RING_SIZE                                               16
+// Bit of a sensor in the mask for ADC_selectChannels
+#define ADC_CHANNEL(sensor)                                 (1 << (sensor))
+// Largest 14-bit result, a window up to it never fires on the high side
+#define ADC_WINDOW_MAX                                              0x3FFF
+
+#define KEYPAD_WAIT_FOREVER                                         0xFFFFFFFF
+#define SWITCH_WAIT_FOREVER                                         0xFFFFFFFF
+
+typedef struct _SwitchEvent
+{
+    int pin;            // 1 (S1), 4 (S2) or 5 (Button)
+    bool pressed;       // true on press, false on release
+    uint32_t timestamp; // Timebase ticks of the first edge
+} SwitchEvent;
+
+typedef struct _KeypadEvent
+{
+    char key;           // keypad_map character
+    bool pressed;       // true on key-down, false on key-up
+    uint32_t timestamp; // Timebase ticks when the key first changed
+} KeypadEvent;
+
 static char keypad_map[4][4] =
         { { '1', '2', '3', 'A' }, { '4', '5', '6', 'B' },
           { '7', '8', '9', 'C' }, { '*', '0', '#', 'D' } };
@@ -32,8 +58,9 @@ static char keypad_map[4][4] =
 /*!
  * \brief This function initializes the inputs for the system
  *
- * This function initializes P1.1, P1.4, and P1.5 for switch inputs, P4.0 for
- * keypad I/O, and ADC14.
+ * This function initializes P1.1, P1.4, and P1.5 for switch inputs, P4 for
+ * keypad I/O, and ADC14. Tick_init and DMAControl_init must be called
+ * first.
  *
  * \return None
  */
@@ -42,8 +69,8 @@ extern void inputs_init(void);
 /*!
  * \brief This function determines whether a switch is pressed
  *
- * This function gets the value at the pin and transforms it into a boolean to
- * convey whether or not the switch is pressed
+ * This function returns the debounced state kept by the switch interrupts, it
+ * does not read the pin.
  *
  * \param pin is the pin to check the input
  *          Valid values are:
@@ -55,16 +82,168 @@ extern void inputs_init(void);
  */
 extern bool switch_pressed(int pin);
 
+/*!
+ * \brief This function samples the switches after the debounce time
+ *
+ * This function is run by a software timer 10 ms after a switch edge. Switches
+ * whose level differs from their debounced state queue a press or release
+ * event, and their edge interrupts are re-armed.
+ *
+ * \return None
+ */
+extern void Switch_debounce(void);
+
+/*!
+ * \brief This function gets the next switch event without waiting
+ *
+ * \param event is where the event is stored
+ *
+ * \return true if an event was taken from the queue, false if it was empty
+ */
+extern bool switch_poll(SwitchEvent *event);
+
+/*!
+ * \brief This function waits for the next switch event
+ *
+ * This function sleeps between interrupts until an event is queued or the
+ * timeout expires.
+ *
+ * \param event is where the event is stored
+ * \param timeout is the most milliseconds to wait, or SWITCH_WAIT_FOREVER
+ *
+ * \return true if an event was read, false on timeout
+ */
+extern bool switch_read(SwitchEvent *event, uint32_t timeout);
+
+/*!
+ * \brief This function scans the keypad once
+ *
+ * This function is run by a software timer every 2 ms while any key is down.
+ * It debounces the keys and queues key-down and key-up events. Once every key
+ * is released it stops the timer and waits for the next column edge on P4.
+ *
+ * \return None
+ */
+extern void keypad_scan(void);
+
+/*!
+ * \brief This function gets the next keypad event without waiting
+ *
+ * \param event is where the event is stored
+ *
+ * \return true if an event was taken from the queue, false if it was empty
+ */
+extern bool keypad_poll(KeypadEvent *event);
+
+/*!
+ * \brief This function waits for the next keypad event
+ *
+ * This function sleeps between interrupts until an event is queued or the
+ * timeout expires. Keys pressed before the call are returned in order.
+ *
+ * \param event is where the event is stored
+ * \param timeout is the most milliseconds to wait, or KEYPAD_WAIT_FOREVER
+ *
+ * \return true if an event was read, false on timeout
+ */
+extern bool keypad_read(KeypadEvent *event, uint32_t timeout);
+
 /*!
  * \brief This function retrieves input from the keypad
  *
- * This function rotates through the row (output) pins to determine if and what
- * is being pressed on the keypad.
+ * This function waits for the next key-down event from the keypad queue.
+ * Key-up events are skipped.
  *
  * \return char corresponding to the keypad input
  */
 extern char keypad_get_input(void);
 
+/*!
+ * \brief This function arms the comparator window of a sensor
+ *
+ * This function has the ADC14 compare every raw sample of the sensor against
+ * the window in hardware. The first sample below low or above high sets the
+ * sensor's crossed flag and posts WAKE_ADC, so a task can sleep until then
+ * instead of polling. Only one window is armed at a time. Use 0 for low or
+ * ADC_WINDOW_MAX for high to watch only one side.
+ *
+ * Thresholds are in 14-bit counts and are rounded outwards to the sensor's
+ * resolution. The sensor must be selected with ADC_selectChannels first.
+ *
+ * \param channel is SENSOR_THERM or SENSOR_PHOTO
+ * \param low is the lower threshold, samples below it cross
+ * \param high is the upper threshold, samples above it cross
+ *
+ * \return None
+ */
+extern void ADC_armWindow(int channel, uint16_t low, uint16_t high);
+
+/*!
+ * \brief This function disarms the comparator window of a sensor
+ *
+ * \param channel is SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return None
+ */
+extern void ADC_disarmWindow(int channel);
+
+/*!
+ * \brief This function checks whether a sensor's window was crossed
+ *
+ * The comparator sees raw samples, so one noisy conversion crosses it. Check
+ * the filtered reading from Sensor_read before acting on a crossing.
+ *
+ * \param channel is SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return true if a sample of the sensor left the window since
+ *          ADC_armWindow
+ */
+extern bool ADC_windowCrossed(int channel);
+
+/*!
+ * \brief This function selects the sensors the ADC14 converts
+ *
+ * This function rebuilds the conversion sequence so only the given sensors
+ * are converted. Each sensor has its own resolution and rate: the
+ * potentiometer uses 14 bits every servo period (25 ms), the thermistor and
+ * photoresistor use 10 bits every other period. Samples are still scaled to
+ * 14 bits. Each selected sensor is converted once right away so its snapshot
+ * is fresh. With no sensors the ADC14 is powered down.
+ *
+ * \param channels is a mask of ADC_CHANNEL(sensor) bits, 0 for none
+ *
+ * \return None
+ */
+extern void ADC_selectChannels(uint8_t channels);
+
+/*!
+ * \brief This function gets the number of samples of an ADC channel
+ *
+ * This function can be used to tell whether new samples arrived since the
+ * last read. It grows by ADC_FRAMES_PER_BLOCK once per DMA block while the
+ * channel is selected.
+ *
+ * \param channel is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ *
+ * \return the number of samples written to the channel's ring
+ */
+extern uint32_t ADC_sampleCount(int channel);
+
+/*!
+ * \brief This function copies the newest samples of an ADC channel
+ *
+ * This function copies up to count samples from the channel's ring, oldest
+ * first. The newest block can be overwritten while copying, so at most
+ * ADC_RING_SIZE - ADC_FRAMES_PER_BLOCK samples are returned.
+ *
+ * \param channel is SENSOR_POT, SENSOR_THERM or SENSOR_PHOTO
+ * \param samples is where the samples are copied
+ * \param count is the number of samples wanted
+ *
+ * \return the number of samples copied
+ */
+extern int ADC_readRing(int channel, uint16_t *samples, int count);
+
 #ifdef __cplusplus
 }
 #endif
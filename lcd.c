@@ -12,20 +12,44 @@
 /* DriverLib Includes */
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 
+/* Standard Includes */
+#include <string.h>
+
 #include "lcd.h"
 #include "delays.h"
+#include "Probe.h"
+#include "Trace.h"
 
 #define NONHOME_MASK        0xFC
 
 #define LONG_INSTR_DELAY    2000
 #define SHORT_INSTR_DELAY   50
 #define PINS_FOUR_BIT       0xF0
+#define BUSY_FLAG_MASK      0x80
+// Each poll has two 1 us strobes, so this never gives up before the
+// worst-case instruction time has passed
+#define BUSY_POLL_LIMIT     (LONG_INSTR_DELAY / 2)
+
+#define CURSOR_UNKNOWN      0xFF
+
+uint_fast8_t RS_Port, RW_Port, EN_Port, DB_Port;
+uint_fast16_t RS_Pin, RW_Pin, EN_Pin;
 
-uint_fast8_t RS_Port, EN_Port, DB_Port;
-uint_fast16_t RS_Pin, EN_Pin;
+/* True when R/W is wired and the busy flag is polled instead of delaying */
+static bool busyFlagMode = false;
 
-void configLCD(uint_fast8_t rsPort, uint_fast16_t rsPin, uint_fast8_t enPort,
-               uint_fast16_t enPin, uint_fast8_t dbPort)
+/* Shadow framebuffer: frame holds what the tasks want on screen, shown holds
+ * what the LCD currently displays. flushFrame only sends the differences. */
+static char frame[LCD_LINES][LCD_COLUMNS];
+static char shown[LCD_LINES][LCD_COLUMNS];
+/* DDRAM address the LCD cursor is at, CURSOR_UNKNOWN if not tracked */
+static uint8_t cursorAddress = CURSOR_UNKNOWN;
+/* False when the LCD was written directly and shown can no longer be trusted */
+static bool frameSynced = false;
+
+void configLCD(uint_fast8_t rsPort, uint_fast16_t rsPin, uint_fast8_t rwPort,
+               uint_fast16_t rwPin, uint_fast8_t enPort, uint_fast16_t enPin,
+               uint_fast8_t dbPort)
 {
     GPIO_setOutputLowOnPin(enPort, enPin);
 
@@ -33,10 +57,20 @@ void configLCD(uint_fast8_t rsPort, uint_fast16_t rsPin, uint_fast8_t enPort,
     GPIO_setAsOutputPin(enPort, enPin);
     GPIO_setAsOutputPin(dbPort, PINS_FOUR_BIT);
 
+    // R/W low selects write, reads only happen while polling the busy flag
+    busyFlagMode = rwPin != LCD_PIN_NONE;
+    if (busyFlagMode)
+    {
+        GPIO_setOutputLowOnPin(rwPort, rwPin);
+        GPIO_setAsOutputPin(rwPort, rwPin);
+    }
+
     RS_Port = rsPort;
+    RW_Port = rwPort;
     EN_Port = enPort;
     DB_Port = dbPort;
     RS_Pin = rsPin;
+    RW_Pin = rwPin;
     EN_Pin = enPin;
 }
 
@@ -61,6 +95,58 @@ void instructionDelay(uint8_t mode, uint8_t instruction)
     }
 }
 
+/*!
+ * Function to read one nibble from the LCD with an Enable strobe.
+ * R/W must already be high and DB4-7 set as inputs.
+ *
+ * \return the nibble in bits 4-7, matching the DB4-7 pins
+ */
+uint8_t readNibble(void)
+{
+    uint8_t nibble = 0;
+    int bit;
+    GPIO_setOutputHighOnPin(EN_Port, EN_Pin);
+    delayMicroSec(1);
+    for (bit = 4; bit < 8; bit++)
+    {
+        if (GPIO_getInputPinValue(DB_Port, 1 << bit) == GPIO_INPUT_PIN_HIGH)
+        {
+            nibble |= 1 << bit;
+        }
+    }
+    GPIO_setOutputLowOnPin(EN_Port, EN_Pin);
+    return nibble;
+}
+
+/*!
+ * Function to wait for the LCD to finish an instruction by polling the busy
+ * flag. Each poll reads the busy flag and address counter byte as two nibbles.
+ *
+ * \return true if the LCD became ready, false if it never answered within
+ *          BUSY_POLL_LIMIT polls
+ */
+bool waitWhileBusy(void)
+{
+    uint8_t status = BUSY_FLAG_MASK;
+    int polls;
+
+    GPIO_setAsInputPin(DB_Port, PINS_FOUR_BIT);
+    GPIO_setOutputLowOnPin(RS_Port, RS_Pin);
+    GPIO_setOutputHighOnPin(RW_Port, RW_Pin);
+    for (polls = 0; (status & BUSY_FLAG_MASK) && polls < BUSY_POLL_LIMIT;
+            polls++)
+    {
+        // BF and AC6-4 first, then AC3-0
+        status = readNibble();
+        status |= readNibble() >> 4;
+    }
+    // Release the bus before driving DB4-7 again
+    GPIO_setOutputLowOnPin(RW_Port, RW_Pin);
+    GPIO_setAsOutputPin(DB_Port, PINS_FOUR_BIT);
+
+    return !(status & BUSY_FLAG_MASK);
+}
+
 /*!
  * Function to write instruction/data to LCD.
  *
@@ -73,6 +159,7 @@ void instructionDelay(uint8_t mode, uint8_t instruction)
  */
 void writeInstruction(uint8_t mode, uint8_t instruction, bool init)
 {
+    PROBE_BEGIN(probe);
     GPIO_setOutputLowOnPin(DB_Port, PINS_FOUR_BIT);
     if (mode == DATA_MODE)
     {
@@ -96,11 +183,24 @@ void writeInstruction(uint8_t mode, uint8_t instruction, bool init)
         GPIO_setOutputLowOnPin(EN_Port, EN_Pin);
     }
 
+    // Busy flag is not valid until the 4-bit initialization writes are done
+    if (busyFlagMode && !init)
+    {
+        if (waitWhileBusy())
+        {
+            PROBE_END(probe, PROBE_LCD_INSTRUCTION);
+            return;
+        }
+        // No answer, R/W is not really wired, use timed delays from now on
+        busyFlagMode = false;
+    }
     instructionDelay(mode, instruction);
+    PROBE_END(probe, PROBE_LCD_INSTRUCTION);
 }
 
 void commandInstruction(uint8_t command, bool init)
 {
+    frameSynced = false;
     writeInstruction(CTRL_MODE, command, init);
 }
 
@@ -141,15 +241,23 @@ void initLCD(void)
     // Initialization complete, turn ON display
     commandInstruction(DISPLAY_CTRL_MASK | D_FLAG_MASK, false);
     delayMilliSec(5);
+
+    // Display was cleared above, so both buffers start out blank
+    memset(frame, ' ', sizeof(frame));
+    memset(shown, ' ', sizeof(shown));
+    cursorAddress = LINE1_OFFSET;
+    frameSynced = true;
 }
 
 void printChar(char character)
 {
+    frameSynced = false;
     dataInstruction(character);
 }
 
 void printString(char *chars, int length)
 {
+    PROBE_BEGIN(probe);
     int i;
     for (i = 0; i < length; i++)
     {
@@ -166,4 +274,75 @@ void printString(char *chars, int length)
             printChar(' ');
         }
     }
+    PROBE_END(probe, PROBE_LCD_PRINT);
+}
+
+void clearFrame(void)
+{
+    memset(frame, ' ', sizeof(frame));
+}
+
+void setFrameChar(int line, int column, char character)
+{
+    if (line < 0 || line >= LCD_LINES || column < 0 || column >= LCD_COLUMNS)
+    {
+        return;
+    }
+    frame[line][column] = character == 0 ? ' ' : character;
+}
+
+void setFrameString(int line, int column, char *chars, int length)
+{
+    int i;
+    for (i = 0; i < length; i++)
+    {
+        if (chars[i] == '\n')
+        {
+            line++;
+            column = 0;
+            continue;
+        }
+        setFrameChar(line, column++, chars[i]);
+    }
+}
+
+void flushFrame(void)
+{
+    PROBE_BEGIN(probe);
+    const uint8_t lineOffsets[LCD_LINES] = { LINE1_OFFSET, LINE2_OFFSET };
+
+    if (!frameSynced)
+    {
+        // Contents unknown after a direct write, force every cell to resend
+        memset(shown, 0, sizeof(shown));
+        cursorAddress = CURSOR_UNKNOWN;
+        frameSynced = true;
+    }
+
+    int line, column, written = 0;
+    for (line = 0; line < LCD_LINES; line++)
+    {
+        for (column = 0; column < LCD_COLUMNS; column++)
+        {
+            if (frame[line][column] == shown[line][column])
+            {
+                continue;
+            }
+            // Only move the cursor when this cell doesn't follow the last one
+            uint8_t address = lineOffsets[line] + column;
+            if (cursorAddress != address)
+            {
+                writeInstruction(CTRL_MODE, SET_CURSOR_MASK | address, false);
+            }
+            writeInstruction(DATA_MODE, frame[line][column], false);
+            shown[line][column] = frame[line][column];
+            cursorAddress = address + 1;
+            written++;
+        }
+    }
+    if (written)
+    {
+        Trace_record(TRACE_LCD_FLUSH, written);
+    }
+    PROBE_END(probe, PROBE_LCD_FLUSH);
 }
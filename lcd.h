@@ -26,6 +26,9 @@ extern "C"
 #define DATA_MODE       1
 #define LINE1_OFFSET    0x0
 #define LINE2_OFFSET    0x40
+#define LCD_LINES       2
+#define LCD_COLUMNS     16
+#define LCD_PIN_NONE    0
 
 /* Instruction masks */
 #define CLEAR_DISPLAY_MASK  0x01
@@ -70,7 +73,12 @@ extern "C"
  *  \brief This function configures the selected pins for an LCD
  *
  *  This function configures the selected pins as output pins to interface
- *      with a Hitachi HD44780 LCD in 4-bit mode.
+ *      with a Hitachi HD44780 LCD in 4-bit mode. If the R/W line is wired,
+ *      instructions wait by polling the busy flag instead of sleeping for the
+ *      worst-case execution time. If it is not wired, pass LCD_PIN_NONE as
+ *      rwPin and the fixed delays are used. A poll costs more than the 50 us
+ *      delay at 3 MHz, so polling only pays off at a faster MCLK and on the
+ *      long instructions.
  *         Valid values for ports are:
  *         - \b GPIO_PORT_P1
  *         - \b GPIO_PORT_P2
@@ -96,6 +104,9 @@ extern "C"
  *
  *  \param rsPort is the port for the RS signal
  *  \param rsPin is the pin in the selected port for the RS signal
+ *  \param rwPort is the port for the R/W signal
+ *  \param rwPin is the pin in the selected port for the R/W signal, or
+ *          LCD_PIN_NONE if R/W is tied low
  *  \param enPort is the port for the Enable signal
  *  \param enPin is the pin in the selected port for the Enable signal
  *  \param dbPort is the port for DB4-7
@@ -105,6 +116,7 @@ extern "C"
  *  \return None
  */
 extern void configLCD(uint_fast8_t rsPort, uint_fast16_t rsPin,
+                    uint_fast8_t rwPort, uint_fast16_t rwPin,
                     uint_fast8_t enPort, uint_fast16_t enPin,
                     uint_fast8_t dbPort);
 
@@ -155,6 +167,59 @@ extern void printString(char* chars, int length);
  */
 extern void commandInstruction(uint8_t command, bool init);
 
+/*!
+ *  \brief This function blanks the shadow framebuffer
+ *
+ *  This function fills the framebuffer with spaces. Nothing is sent to the LCD
+ *  until flushFrame is called, and the LCD is never sent a clear instruction.
+ *
+ *  \return None
+ */
+extern void clearFrame(void);
+
+/*!
+ *  \brief This function writes a character into the shadow framebuffer
+ *
+ *  This function stores a character in RAM at the given cell. Cells outside
+ *  of the 2x16 display are ignored, and a 0 is stored as a space.
+ *
+ *  \param line is the display line, 0 or 1
+ *  \param column is the display column, 0 - 15
+ *  \param character is the character to store
+ *
+ *  \return None
+ */
+extern void setFrameChar(int line, int column, char character);
+
+/*!
+ *  \brief This function writes a String into the shadow framebuffer
+ *
+ *  This function stores a string of ASCII characters starting at the given
+ *  cell. If the character is \n, writing continues at the start of the next
+ *  line. Characters past the end of a line are dropped.
+ *
+ *  \param line is the display line to start on, 0 or 1
+ *  \param column is the display column to start on, 0 - 15
+ *  \param chars is the String or character array to store
+ *  \param length is the length of the String
+ *
+ *  \return None
+ */
+extern void setFrameString(int line, int column, char *chars, int length);
+
+/*!
+ *  \brief This function sends the changed framebuffer cells to the LCD
+ *
+ *  This function compares the framebuffer against what the LCD is showing and
+ *  only writes the cells that differ. A cursor move is only sent when the next
+ *  changed cell does not directly follow the previous one. If printChar,
+ *  printString or commandInstruction were used since the last flush, the
+ *  whole frame is resent.
+ *
+ *  \return None
+ */
+extern void flushFrame(void);
+
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
@@ -1,7 +1,7 @@
 /*
  * Author:      Cooper Brotherton and Jesus Capo
  * Date:        February 23, 2021
- * Libraries:   GPIO, Timer32, Timer A, ADC14, from DriverLib
+ * Libraries:   GPIO, Timer A, ADC14, from DriverLib
  */
 /******************************************************************************
  * MSP432 Capstone Project ECE230 Winter 2020-2021
@@ -32,7 +32,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string.h>
 #include <time.h>
 
@@ -42,19 +41,52 @@
 #include "outputs.h"
 #include "delays.h"
 #include "Timer.h"
+#include "Clock.h"
+#include "Timebase.h"
+#include "Tick.h"
+#include "Sound.h"
+#include "Motion.h"
+#include "Power.h"
+#include "Probe.h"
+#include "Profile.h"
 #include "Tasks.h"
+#include "DMAControl.h"
+#include "Sensor.h"
+#include "Format.h"
+#include "Telemetry.h"
+#include "Trace.h"
 
 #define NUM_OF_TASKS                                                7
+#define TASK_TICK_MS                                                10
+/* The salary bonus is $1 for every 10 us a hit beats REACTION_PAR_US by */
+#define REACTION_PAR_US                                             500000
+#define REACTION_BONUS_US                                           10
+/* R/W of the LCD is tied low on this board, a board with it on P3.4 can set
+ * GPIO_PIN4 on the command line to poll the busy flag */
+#ifndef LCD_RW_PIN
+#define LCD_RW_PIN                                                  LCD_PIN_NONE
+#endif
 
 typedef enum _tasks
 {
     Password, Lights, Temp, Direction, Power, Reaction, Binary
 } Tasks;
 
-static int digitalValue;
 static volatile Tasks taskList[NUM_OF_TASKS];
+/* Sensors each Task reads, indexed by Task */
+static const uint8_t taskSensors[NUM_OF_TASKS] = {
+        0, ADC_CHANNEL(SENSOR_PHOTO), ADC_CHANNEL(SENSOR_THERM),
+        ADC_CHANNEL(SENSOR_POT), ADC_CHANNEL(SENSOR_POT), 0, 0 };
 
 Tasks currentTask;
+/* Sleep counters of the last game, see Power.h */
+PowerStats gamePowerStats;
+/* Reaction time of the last game, see Tasks.h */
+ReactionStats gameReactionStats;
+/* Wakes the task loop while the game runs */
+static TickTimer taskTimer;
+/* Set by timeUp, the task loop ends the game */
+static volatile bool fired = false;
 
 /*!
  * \brief This function sets up the project
@@ -67,10 +99,20 @@ Tasks currentTask;
 void setup(void)
 {
     WDT_A_holdTimer();
+    Clock_init();
+    Probe_init();
+    Profile_init();
+    Trace_init();
 
+    Timebase_init();
+    Tick_init();
+    DMAControl_init();
+    Telemetry_init();
     inputs_init();
     outputs_init();
+    Motion_init();
     Timer_init();
+    Sound_init();
 
     const uint8_t port_mapping[] = {
     //Port P2: none, none, none, none, none, none, buzzer, servo
@@ -82,11 +124,18 @@ void setup(void)
     PMAP_DISABLE_RECONFIGURATION);
 
     // LCD initialization
-    configLCD(GPIO_PORT_P3, GPIO_PIN3, GPIO_PORT_P3, GPIO_PIN2, GPIO_PORT_P6);
-    initDelayTimer(CS_getMCLK());
-    initLCD();
-
+    // Without R/W the LCD uses timed delays
+    configLCD(GPIO_PORT_P3, GPIO_PIN3, GPIO_PORT_P3, LCD_RW_PIN, GPIO_PORT_P3,
+              GPIO_PIN2, GPIO_PORT_P6);
+    initDelayTimer(Clock_getMCLK());
+    // Every driver that counts MCLK is listening by now
+    Clock_setProfile(CLOCK_GAME_PROFILE);
+    // Delays sleep until an interrupt wakes them, so enable interrupts first
     Interrupt_enableMaster();
+    initLCD();
+    // Send what was recorded before a warm reset, then record this game
+    Trace_sendPrevious();
+    Profile_start(PROFILE_HZ);
 }
 
 /*!
@@ -104,45 +153,55 @@ void setup(void)
  */
 int setDifficulty(void)
 {
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    commandInstruction(RETURN_HOME_MASK, false);
-    printString("Set difficulty:\nS1:select S2:set", 32);
+    clearFrame();
+    setFrameString(0, 0, "Set difficulty:\nS1:select S2:set", 32);
+    flushFrame();
     int select = 0;
-    // Let users interact with the mechanic before letting them set
-    while (!switch_pressed(1))
-        ;
-    commandInstruction(RETURN_HOME_MASK, false);
-    printString("Easy            ", 16);
-    while (switch_pressed(1))
+    SwitchEvent event;
+    // Ignore presses made during the welcome screen
+    while (switch_poll(&event))
         ;
+    // Let users interact with the mechanic before letting them set
+    do
+    {
+        switch_read(&event, SWITCH_WAIT_FOREVER);
+    }
+    while (!(event.pressed && event.pin == 1));
+    setFrameString(0, 0, "Easy            ", 16);
+    flushFrame();
     // Loop to change difficulty until S2 press
-    while (!switch_pressed(4))
+    while (1)
     {
-        if (switch_pressed(1))
+        switch_read(&event, SWITCH_WAIT_FOREVER);
+        if (!event.pressed)
+        {
+            continue;
+        }
+        if (event.pin == 4)
+        {
+            break;
+        }
+        if (event.pin == 1)
         {
             // Display new difficulty and rotate
             select = (select + 1) % 3;
-            commandInstruction(RETURN_HOME_MASK, false);
             switch (select)
             {
             case 0:
-                printString("Easy  ", 6);
+                setFrameString(0, 0, "Easy  ", 6);
                 break;
             case 1:
-                printString("Medium", 6);
+                setFrameString(0, 0, "Medium", 6);
                 break;
             case 2:
-                printString("Hard  ", 6);
+                setFrameString(0, 0, "Hard  ", 6);
                 break;
             default:
-                printString("Easy  ", 6);
+                setFrameString(0, 0, "Easy  ", 6);
                 select = 0;
             }
-
+            flushFrame();
         }
-        // Wait until S1 has been depressed
-        while (switch_pressed(1))
-            ;
     }
 
     return select;
@@ -176,11 +235,151 @@ void generateRandomOrder(void)
     }
 }
 
+/*!
+ * \brief This function wakes the task loop periodically
+ *
+ * This function is run by taskTimer every TASK_TICK_MS so time based tasks
+ * get stepped even when no input arrives.
+ *
+ * \return None
+ */
+void taskTick(void)
+{
+    Power_wake(WAKE_TIMER);
+}
+
+/*!
+ * \brief This function starts a Task
+ *
+ * The ADC14 is switched over to the sensors the Task reads first, or powered
+ * down if it reads none.
+ *
+ * \param task is the Task to start
+ * \param difficulty is the difficulty the game is running at
+ *
+ * \return None
+ */
+void startTask(Tasks task, int difficulty)
+{
+    Telemetry_log(TELEMETRY_TASK_START, task);
+    Trace_record(TRACE_TASK_START, task);
+    ADC_selectChannels(taskSensors[task]);
+    switch (task)
+    {
+    case Password:
+        taskPassword_start(difficulty);
+        break;
+    case Lights:
+        taskLights_start(difficulty);
+        break;
+    case Temp:
+        taskTemp_start(difficulty);
+        break;
+    case Direction:
+        taskDirection_start(difficulty);
+        break;
+    case Power:
+        taskDivertPower_start(difficulty);
+        break;
+    case Reaction:
+        taskReaction_start(difficulty);
+        break;
+    case Binary:
+        taskBinary_start(difficulty);
+        break;
+    default:
+        clearFrame();
+        setFrameString(0, 0, "Error 404:\nTask not found", 25);
+    }
+}
+
+/*!
+ * \brief This function runs one step of a Task
+ *
+ * \param task is the Task to step
+ *
+ * \return true if the Task is complete
+ */
+bool stepTask(Tasks task)
+{
+    bool done;
+    PROBE_BEGIN(probe);
+    switch (task)
+    {
+    case Password:
+        done = taskPassword_step();
+        break;
+    case Lights:
+        done = taskLights_step();
+        break;
+    case Temp:
+        done = taskTemp_step();
+        break;
+    case Direction:
+        done = taskDirection_step();
+        break;
+    case Power:
+        done = taskDivertPower_step();
+        break;
+    case Reaction:
+        done = taskReaction_step();
+        break;
+    case Binary:
+        done = taskBinary_step();
+        break;
+    default:
+        return true;
+    }
+    // Each step is timed here rather than at every return in Tasks.c
+    PROBE_END(probe, PROBE_TASK_PASSWORD + task);
+    return done;
+}
+
+/*!
+ * \brief This function runs when the game timer runs out
+ *
+ * This function is called from PendSV, so it only tells the task loop, which
+ * owns the LCD and the buzzer.
+ *
+ * \return None
+ */
+void timeUp(void)
+{
+    fired = true;
+    Power_wake(WAKE_TIMER);
+}
+
+/*!
+ * \brief This function ends the game when the time ran out
+ *
+ * This function handles the game over mechanism of the game by displaying
+ * "You're fired!" to the LCD, turning on P1.0, and playing SOUND_FIRED. The
+ * system locks up until the melody is over, which aborts. It is called from
+ * the task loop once timeUp ran, and never returns.
+ *
+ * \return None
+ */
+void gameOver(void)
+{
+    Tick_cancel(&taskTimer);
+    Timer_stop();
+    clearFrame();
+    setFrameString(0, 0, "You're fired!", 13);
+    flushFrame();
+    GPIO_setOutputHighOnPin(BLINK_PORT, BLINK_PIN);
+    // The recording survives a warm reset, see Trace.h
+    Trace_record(TRACE_FIRED, currentTask);
+    // The game ends once the jingle is over
+    Sound_play(SOUND_FIRED, SOUND_TEMPO, abort);
+    Power_sleep(0);
+}
+
 /*!
  * \brief This function handles the game flow
  *
  * This function handles the flow and order of the game by calling initialization
- * functions, then starting the game and calling the appropriate Task function.
+ * functions, then starting the game and stepping the appropriate Task each time
+ * the CPU wakes up, idling in between.
  * It also handles the game ending sequence.
  *
  * \return int
@@ -190,137 +389,79 @@ int main(void)
     setup();
 
     /* ----- Game introduction ----- */
-    printString("Welcome to\nEngineering Sim!", 27);
+    setFrameString(0, 0, "Welcome to\nEngineering Sim!", 27);
+    flushFrame();
     delayMilliSec(5000);
 
     /* ----- Game setup ----- */
     const int difficulty = setDifficulty();
+    Telemetry_log(TELEMETRY_DIFFICULTY, difficulty);
+    Trace_record(TRACE_GAME_START, difficulty);
     srand(time(0));
 
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
+    clearFrame();
+    flushFrame();
     generateRandomOrder();
 
     /* ----- Gameplay ----- */
     // Start game timer and blink/buzzer timer
-    Timer32_setCount(TIMER32_0_BASE, 60 * CS_getMCLK());
-    Timer32_startTimer(TIMER32_0_BASE, true);
-    Timer_A_startCounter(TIMER_A0_BASE, TIMER_A_UP_MODE);
-    Timer_A_startCounter(TIMER_A2_BASE, TIMER_A_UPDOWN_MODE);
+    Timer_start(60000, timeUp);
+    Tick_start(&taskTimer, TASK_TICK_MS, TASK_TICK_MS, taskTick);
 
-    // task completion loop
-    int taskIndex;
-    for (taskIndex = 0; taskIndex < NUM_OF_TASKS; taskIndex++)
-    {
-        currentTask = taskList[taskIndex];
-        switch (currentTask)
-        {
-        case Password:
-            taskPassword(difficulty);
-            break;
-        case Lights:
-            taskLights(difficulty, &digitalValue);
-            break;
-        case Temp:
-            taskTemp(difficulty, &digitalValue);
-            break;
-        case Direction:
-            taskDirection(difficulty, &digitalValue);
-            break;
-        case Power:
-            taskDivertPower(difficulty, &digitalValue);
-            break;
-        case Reaction:
-            taskReaction(difficulty);
-            break;
-        case Binary:
-            taskBinary(difficulty);
-            break;
-        default:
-            commandInstruction(RETURN_HOME_MASK, false);
-            commandInstruction(CLEAR_DISPLAY_MASK, false);
-            printString("Error 404:\nTask not found", 25);
-        }
-    }
-    // Game completed
-    Timer32_haltTimer(TIMER32_0_BASE);
-    Timer_A_stopTimer(TIMER_A0_BASE);
-    Timer_A_stopTimer(TIMER_A2_BASE);
-    GPIO_setOutputLowOnPin(BLINK_PORT, BLINK_PIN);
-    commandInstruction(RETURN_HOME_MASK, false);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    long score = TIMER32_1->VALUE * (1 + difficulty * 0.3) / 420;
-    char sal[26];
-    sprintf(sal, "Good job!\nSalary: $%6d", score);
-    printString(sal, 26);
-}
+    Power_resetStats();
 
-/*!
- * \brief This function handles analog inputs
- *
- * This function handles the analog inputs of the potentiometer, thermistor, and
- * photoresistor and updates digitalValue based on the current task.
- *
- * \return None
- */
-void ADC14_IRQHandler(void)
-{
-    uint64_t status = ADC14_getEnabledInterruptStatus();
-    ADC14_clearInterruptFlag(status);
-    // Potentiometer
-    if (ADC_INT3 & status)
+    // task completion loop, every wake-up steps the current task
+    int taskIndex = 0;
+    currentTask = taskList[taskIndex];
+    startTask(currentTask, difficulty);
+    while (1)
     {
-        // if direction or power
-        if (currentTask == Direction || currentTask == Power)
+        const bool done = stepTask(currentTask);
+        if (fired)
         {
-            digitalValue = ADC14_getResult(ADC_INT3);
+            gameOver();
         }
-        else
+        if (done)
         {
-            ADC14_toggleConversionTrigger();
+            Telemetry_log(TELEMETRY_TASK_DONE, currentTask);
+            Trace_record(TRACE_TASK_DONE, currentTask);
+            if (++taskIndex == NUM_OF_TASKS)
+            {
+                break;
+            }
+            Sound_play(SOUND_TASK_DONE, SOUND_TEMPO, 0);
+            currentTask = taskList[taskIndex];
+            startTask(currentTask, difficulty);
         }
+        flushFrame();
+        Power_sleep(WAKE_TIMER | WAKE_KEYPAD | WAKE_SWITCHES | WAKE_ADC);
     }
-    // Thermistor
-    if (ADC_INT4 & status)
+    Tick_cancel(&taskTimer);
+    ADC_selectChannels(0);
+    // Game completed
+    Timer_stop();
+    clearFrame();
+    // Time left in 3 MHz ticks / 420, plus 30 % per difficulty level
+    uint32_t score = Timer_getRemainingMs() * 50 / 7 * (10 + difficulty * 3) / 10;
+    // Plus a bonus for a quick reaction
+    taskReaction_getStats(&gameReactionStats);
+    if (gameReactionStats.micros < REACTION_PAR_US)
     {
-        if (currentTask == Temp)
-        {
-
-            digitalValue = ADC14_getResult(ADC_INT4);
-        }
-        else
-        {
-            ADC14_toggleConversionTrigger();
-        }
+        score += (REACTION_PAR_US - gameReactionStats.micros)
+                / REACTION_BONUS_US;
     }
-    // Photoresistor
-    if (ADC_INT5 & status)
-    {
-        if (currentTask == Lights)
-        {
-            digitalValue = ADC14_getResult(ADC_INT5);
-        }
-        else
-        {
-            ADC14_toggleConversionTrigger();
-        }
-    }
-}
+    char sal[FORMAT_MAX_DIGITS];
+    setFrameString(0, 0, "Good job!\nSalary: $", 19);
+    setFrameString(1, 9, sal, Format_uint(sal, score, 6));
+    flushFrame();
+    Telemetry_log(TELEMETRY_SALARY, score);
+    Trace_record(TRACE_SALARY, score);
 
-/*!
- * \brief This function handles the interrupt of Timer32_0
- *
- * This function handles the game over mechanism of the game by displaying
- * "You're fired!" to the LCD, turning on P1.0, and locking the system up.
- *
- * \return None
- */
-void T32_INT1_IRQHandler(void)
-{
-    Timer32_clearInterruptFlag(TIMER32_0_BASE);
-    commandInstruction(CLEAR_DISPLAY_MASK, false);
-    commandInstruction(RETURN_HOME_MASK, false);
-    printString("You're fired!", 13);
-    GPIO_setOutputHighOnPin(BLINK_PORT, BLINK_PIN);
-    abort();
+    // Keep the residency figures of the game for the debugger
+    Power_getStats(&gamePowerStats);
+    Profile_stop();
+    Profile_send();
+    // LPM3 stops SMCLK, so the UART has to finish first
+    Telemetry_flush();
+    Power_sleepForever();
 }
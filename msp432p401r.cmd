@@ -123,6 +123,8 @@ SECTIONS
     .vtable :   > 0x20000000
     .data   :   > SRAM_DATA
     .bss    :   > SRAM_DATA
+    /* Not zeroed by the boot code, holds the flight recorder, see Trace.h   */
+    .TI.noinit  :   > SRAM_DATA
     .sysmem :   > SRAM_DATA
     .stack  :   > SRAM_DATA (HIGH)
 
@@ -118,10 +118,3 @@ void External_LED_turnOnHex(int value)
         break;
     }
 }
-
-void Servo_setAngle(int value)
-{
-    int multiple = value / 910;
-    servo_PWMConfig.dutyCycle = MAX_ANGLE - multiple * TEN_DEGREES;
-    Timer_A_generatePWM(TIMER_A1_BASE, &servo_PWMConfig);
-}
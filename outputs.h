@@ -29,14 +29,14 @@ extern "C" {
 #define MIN_ANGLE                                                   700
 #define MIDDLE_ANGLE                                                2176
 #define MAX_ANGLE                                                   3652
-#define TEN_DEGREES                                                 164
 
 /*!
  * \brief This function initializes all of the outputs for the system
  *
  * This function initializes the external LEDs on P3 and servo.
  *
- * TA1.1 generates a PWM signal for the servo.
+ * TA1.1 generates a PWM signal for the servo, its pulse width is set by the
+ * motion planner, see Motion.h.
  *
  * \return None
  */
@@ -80,37 +80,6 @@ extern void External_LED_turnOff(void);
  */
 extern void External_LED_turnOnHex(int value);
 
-/*!
- * \brief This function changes the angle of the servo based on the angle
- *
- * This function adjusts the PWM signal sent to the servo and therefore its angle.
- * The larger the value, the larger the angle
- *
- * \param value is 14-bit ADC value. Every 910 corresponds to 10.
- *          Valid values are 0 - 16384.
- *          - \b 0 - 910 0
- *          - \b 911 - 1820 10
- *          - \b 1821 - 2730 20
- *          - \b 2731 - 3640 30
- *          - \b 3641 - 4550 40
- *          - \b 4551 - 5460 50
- *          - \b 5461 - 6370 60
- *          - \b 6371 - 7280 70
- *          - \b 7281 - 8190 90
- *          - \b 8191 - 9100 100
- *          - \b 9101 - 10010 110
- *          - \b 10011 - 10920 120
- *          - \b 10921 - 11830 130
- *          - \b 11831 - 12740 140
- *          - \b 12741 - 13650 150
- *          - \b 13651 - 14560 160
- *          - \b 14561 - 15470 170
- *          - \b 15471 - 16384 180
- *
- * \return None
- */
-extern void Servo_setAngle(int value);
-
 #ifdef __cplusplus
 }
 #endif